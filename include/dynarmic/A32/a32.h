@@ -59,6 +59,12 @@ public:
      */
     void HaltExecution();
 
+    /**
+     * Invalidates all translations cached by the software TLB.
+     * Can be called at any time, including from within a callback.
+     */
+    void FlushSoftwareTLB();
+
     /// View and modify registers.
     std::array<std::uint32_t, 16>& Regs();
     const std::array<std::uint32_t, 16>& Regs() const;
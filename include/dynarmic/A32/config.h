@@ -9,6 +9,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
+
+#include <dynarmic/optimization_flags.h>
 
 namespace Dynarmic {
 namespace A32 {
@@ -55,6 +58,14 @@ struct UserCallbacks {
         return MemoryRead32(vaddr);
     }
 
+    // Returns a host pointer to the 4KiB page of guest code starting at vaddr, or nullptr.
+    // vaddr is always page-aligned. If a pointer is returned, code within that page is read
+    // directly from host memory instead of through MemoryReadCode.
+    // The returned memory must be interpreted as described for MemoryReadCode.
+    virtual const std::uint8_t* GetCodePointer(VAddr /*vaddr*/) {
+        return nullptr;
+    }
+
     // Reads through these callbacks may not be aligned.
     // Memory must be interpreted as if ENDIANSTATE == 0, endianness will be corrected by the JIT.
     virtual std::uint8_t MemoryRead8(VAddr vaddr) = 0;
@@ -76,6 +87,14 @@ struct UserCallbacks {
         return false;
     }
 
+    // This callback is only used when the software TLB is enabled (See: enable_software_tlb).
+    // Returns a host pointer to the start of the 4KiB guest page containing vaddr, or nullptr if
+    // accesses to this page should go through the MemoryRead*/MemoryWrite* callbacks.
+    // Results, including nullptr, are cached until Jit::FlushSoftwareTLB is called.
+    virtual void* TranslateAddress(VAddr /* vaddr */) {
+        return nullptr;
+    }
+
     /// The interpreter must execute exactly num_instructions starting from PC.
     virtual void InterpreterFallback(VAddr pc, size_t num_instructions) = 0;
 
@@ -102,6 +121,20 @@ struct UserConfig {
     /// This is intended to be used for debugging.
     bool enable_optimizations = true;
 
+    /// Determines which IR passes are run on each block. See OptimizationFlag for a description
+    /// of each pass. IR passes are only run if enable_optimizations is true, with the exception
+    /// of the debugging passes.
+    OptimizationFlag optimizations = default_optimizations;
+
+    /// If this is not empty, the IR passes are run in this order instead of the default order.
+    /// A pass may be listed more than once. Passes which are not enabled in optimizations are
+    /// skipped. The debugging passes are always run last and should not be listed here.
+    std::vector<OptimizationFlag> pass_order{};
+
+    bool HasOptimization(OptimizationFlag f) const {
+        return !!(optimizations & f);
+    }
+
     // Page Table
     // The page table is used for faster memory access. If an entry in the table is nullptr,
     // the JIT will fallback to calling the MemoryRead*/MemoryWrite* callbacks.
@@ -116,6 +149,25 @@ struct UserConfig {
     ///       This can be avoided by carefully allocating the memory region.
     bool absolute_offset_page_table = false;
 
+    // Software TLB
+    // A small direct-mapped TLB that is probed by emitted code. Misses are filled by the
+    // TranslateAddress callback. Accesses to pages that do not translate, and accesses that
+    // straddle a page boundary, fall back to the MemoryRead*/MemoryWrite* callbacks.
+    // Use Jit::FlushSoftwareTLB when mappings change.
+    // This is only used if page_table is nullptr.
+    bool enable_software_tlb = false;
+
+    // Flat Memory
+    // If not nullptr, this should point to a single contiguous host buffer backing the guest
+    // address space. Data accesses are performed directly on
+    // flat_memory_base + (vaddr & flat_memory_mask) without any bounds checking, and page_table
+    // and fastmem_pointer are not used. Accesses are not wrapped at the end of the buffer, so it
+    // should be followed by at least 7 bytes of padding.
+    // Exclusive accesses and instruction fetches still go through the memory callbacks.
+    std::uint8_t* flat_memory_base = nullptr;
+    /// Mask applied to guest addresses in flat memory mode.
+    std::uint32_t flat_memory_mask = 0xFFFFFFFF;
+
     // Fastmem Pointer
     // This should point to the beginning of a 4GB address space which is in arranged just like
     // what you wish for emulated memory to be. If the host page faults on an address, the JIT
@@ -66,6 +66,12 @@ public:
      */
     void ExceptionalExit();
 
+    /**
+     * Invalidates all translations cached by the software TLB.
+     * Can be called at any time, including from within a callback.
+     */
+    void FlushSoftwareTLB();
+
     /// Read Stack Pointer
     std::uint64_t GetSP() const;
     /// Modify Stack Pointer
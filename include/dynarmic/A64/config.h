@@ -9,6 +9,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <vector>
+
+#include <dynarmic/optimization_flags.h>
 
 namespace Dynarmic {
 namespace A64 {
@@ -75,6 +78,14 @@ struct UserCallbacks {
         return MemoryRead32(vaddr);
     }
 
+    // Returns a host pointer to the 4KiB page of guest code starting at vaddr, or nullptr.
+    // vaddr is always page-aligned. If a pointer is returned, code within that page is read
+    // directly from host memory instead of through MemoryReadCode.
+    // The returned memory must be interpreted as described for MemoryReadCode.
+    virtual const std::uint8_t* GetCodePointer(VAddr /*vaddr*/) {
+        return nullptr;
+    }
+
     // Reads through these callbacks may not be aligned.
     virtual std::uint8_t MemoryRead8(VAddr vaddr) = 0;
     virtual std::uint16_t MemoryRead16(VAddr vaddr) = 0;
@@ -118,6 +129,14 @@ struct UserCallbacks {
         return false;
     }
 
+    // This callback is only used when the software TLB is enabled (See: enable_software_tlb).
+    // Returns a host pointer to the start of the 4KiB guest page containing vaddr, or nullptr if
+    // accesses to this page should go through the MemoryRead*/MemoryWrite* callbacks.
+    // Results, including nullptr, are cached until Jit::FlushSoftwareTLB is called.
+    virtual void* TranslateAddress(VAddr /*vaddr*/) {
+        return nullptr;
+    }
+
     /// The interpreter must execute exactly num_instructions starting from PC.
     virtual void InterpreterFallback(VAddr pc, size_t num_instructions) = 0;
 
@@ -152,6 +171,20 @@ struct UserConfig {
     /// This is intended to be used for debugging.
     bool enable_optimizations = true;
 
+    /// Determines which IR passes are run on each block. See OptimizationFlag for a description
+    /// of each pass. IR passes are only run if enable_optimizations is true, with the exception
+    /// of the debugging passes.
+    OptimizationFlag optimizations = default_optimizations;
+
+    /// If this is not empty, the IR passes are run in this order instead of the default order.
+    /// A pass may be listed more than once. Passes which are not enabled in optimizations are
+    /// skipped. The debugging passes are always run last and should not be listed here.
+    std::vector<OptimizationFlag> pass_order{};
+
+    bool HasOptimization(OptimizationFlag f) const {
+        return !!(optimizations & f);
+    }
+
     /// When set to true, UserCallbacks::DataCacheOperationRaised will be called when any
     /// data cache instruction is executed. Notably DC ZVA will not implicitly do anything.
     /// When set to false, UserCallbacks::DataCacheOperationRaised will never be called.
@@ -206,6 +239,17 @@ struct UserConfig {
     ///       So there might be wrongly faulted pages which maps to nullptr.
     ///       This can be avoided by carefully allocating the memory region.
     bool absolute_offset_page_table = false;
+    /// Number of levels in the page table. Valid values are between 1 and 4 inclusive.
+    /// With a single level, page_table is a flat array of host page pointers indexed by
+    /// (vaddr >> 12). With more than one level, page_table is the root of a radix tree: the
+    /// page number is split between levels, the last level receiving
+    /// (page_table_address_space_bits - 12) / page_table_levels bits as do all other levels
+    /// except the first, which receives the remainder. Every entry of a non-last level is a
+    /// pointer to the next-level table, and entries of the last level have the same meaning as
+    /// entries of a flat page table. A null entry at any level results in a call to the relevant
+    /// memory callback.
+    /// This is only used if page_table is not nullptr.
+    size_t page_table_levels = 1;
     /// Determines if we should detect memory accesses via page_table that straddle are
     /// misaligned. Accesses that straddle page boundaries will fallback to the relevant
     /// memory callback.
@@ -216,6 +260,24 @@ struct UserConfig {
     /// page boundary.
     bool only_detect_misalignment_via_page_table_on_page_boundary = false;
 
+    /// Enables a small direct-mapped software TLB that is probed by emitted code for 8-bit to
+    /// 64-bit memory accesses. Misses are filled by the TranslateAddress callback. Accesses to
+    /// pages that do not translate, and accesses that straddle a page boundary, fall back to the
+    /// relevant memory callback. Use Jit::FlushSoftwareTLB when mappings change.
+    /// This is only used if page_table is nullptr.
+    bool enable_software_tlb = false;
+
+    /// Pointer to a single contiguous host buffer backing the guest address space. If not
+    /// nullptr, data accesses are performed directly on flat_memory_base + (vaddr &
+    /// flat_memory_mask) without any bounds checking, and page_table is not used.
+    /// Accesses are not wrapped at the end of the buffer, so it should be followed by at least
+    /// 15 bytes of padding.
+    /// Exclusive accesses and instruction fetches still go through the memory callbacks.
+    std::uint8_t* flat_memory_base = nullptr;
+    /// Mask applied to guest addresses in flat memory mode. Must be of the form 2^n - 1.
+    /// This is only used if flat_memory_base is not nullptr.
+    std::uint64_t flat_memory_mask = 0xFFFF'FFFF'FFFF'FFFF;
+
     /// This option relates to translation. Generally when we run into an unpredictable
     /// instruction the ExceptionRaised callback is called. If this is true, we define
     /// definite behaviour for some unpredictable instructions.
@@ -225,6 +287,11 @@ struct UserConfig {
     /// to avoid writting certain unnecessary code only needed for cycle timers.
     bool wall_clock_cntpct = false;
 
+    /// Maximum number of instructions translated into a single block. Long runs of straight-line
+    /// code are split into several blocks, which bounds the time taken to compile any one block.
+    /// 0 means that the length of blocks is not limited.
+    size_t max_instructions_per_block = 0;
+
     /// This enables the fast dispatcher.
     bool enable_fast_dispatch = true;
 
@@ -0,0 +1,92 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace Dynarmic {
+
+/// Passes which may be run on the IR of a block before it is emitted.
+/// Each pass is a single bit, so that a set of passes can be described by a combination of flags.
+enum class OptimizationFlag : std::uint32_t {
+    /// Removes redundant reads and writes of guest registers and flags within a block.
+    GetSetElimination = 0x00000001,
+    /// Removes the final update of the NZCV flags in a block if every statically known successor
+    /// block overwrites the flags before reading them. This requires translating successor blocks
+    /// when a block is compiled. The NZCV flags observed after Run returns, or from memory
+    /// callbacks, may then be stale.
+    CrossBlockFlagElimination = 0x00000002,
+    /// Removes instructions whose results are unused and which have no side-effects.
+    DeadCodeElimination = 0x00000004,
+    /// Folds operations on constant values.
+    ConstantPropagation = 0x00000008,
+    /// Forwards values stored to guest memory to later loads from the same address, and merges
+    /// repeated loads from the same address. Memory barriers, exclusive and atomic accesses and
+    /// exceptions end this tracking.
+    /// Only enable this if guest memory cannot change between two accesses in the same block
+    /// without an intervening barrier. This is not the case if, for example, memory-mapped I/O is
+    /// accessed through the memory callbacks.
+    MemoryForwarding = 0x00000010,
+    /// Replaces reads from read-only memory with constants (See: UserCallbacks::IsReadOnlyMemory).
+    ConstantMemoryReads = 0x00000020,
+    /// Folds floating-point operations on constant values.
+    FPConstantFolding = 0x00000040,
+    /// Simplifies operations using algebraic identities.
+    AlgebraicSimplification = 0x00000080,
+    /// Merges identical pure operations.
+    CommonSubexpressionElimination = 0x00000100,
+    /// Merges adjacent memory accesses into wider ones.
+    MemoryCoalescing = 0x00000200,
+    /// Shares page table lookups between accesses to the same page. (A64 only.)
+    PageLookupSharing = 0x00000400,
+    /// Merges consecutive instructions which fall back to the interpreter into a single call.
+    MergeInterpretBlocks = 0x00000800,
+    /// Emits a block which links back to its own start as a host loop, which keeps frequently
+    /// used guest registers in host registers until the loop exits. This is done by the backend
+    /// rather than by an IR pass, so it should not be listed in a pass order. (A64 only.)
+    SelfLoopBlocks = 0x00001000,
+
+    /// The below are debugging aids rather than optimizations.
+
+    /// Checks that the IR of every block is well-formed before it is emitted.
+    Verification = 0x00010000,
+    /// Prints the IR of every block to stdout before it is emitted.
+    PrintIR = 0x00020000,
+};
+
+constexpr OptimizationFlag no_optimizations = static_cast<OptimizationFlag>(0);
+
+/// Optimizations which are enabled by default: all of the above except CrossBlockFlagElimination
+/// and MemoryForwarding.
+constexpr OptimizationFlag default_optimizations = static_cast<OptimizationFlag>(0x00001FED);
+
+constexpr OptimizationFlag operator~(OptimizationFlag f) {
+    return static_cast<OptimizationFlag>(~static_cast<std::uint32_t>(f));
+}
+
+constexpr OptimizationFlag operator|(OptimizationFlag f1, OptimizationFlag f2) {
+    return static_cast<OptimizationFlag>(static_cast<std::uint32_t>(f1) |
+                                         static_cast<std::uint32_t>(f2));
+}
+
+constexpr OptimizationFlag operator&(OptimizationFlag f1, OptimizationFlag f2) {
+    return static_cast<OptimizationFlag>(static_cast<std::uint32_t>(f1) &
+                                         static_cast<std::uint32_t>(f2));
+}
+
+constexpr OptimizationFlag& operator|=(OptimizationFlag& result, OptimizationFlag f) {
+    return result = result | f;
+}
+
+constexpr OptimizationFlag& operator&=(OptimizationFlag& result, OptimizationFlag f) {
+    return result = result & f;
+}
+
+constexpr bool operator!(OptimizationFlag f) {
+    return f == no_optimizations;
+}
+
+} // namespace Dynarmic
@@ -165,14 +165,28 @@ private:
                            [this](u32 vaddr) { return config.callbacks->MemoryReadCode(vaddr); },
                            {config.define_unpredictable_behaviour, config.hook_hint_instructions});
         if (config.enable_optimizations) {
-            Optimization::A32GetSetElimination(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-            Optimization::A32ConstantMemoryReads(ir_block, config.callbacks);
-            Optimization::ConstantPropagation(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-            Optimization::A32MergeInterpretBlocksPass(ir_block, config.callbacks);
+            if (config.HasOptimization(OptimizationFlag::GetSetElimination)) {
+                Optimization::A32GetSetElimination(ir_block);
+            }
+            if (config.HasOptimization(OptimizationFlag::DeadCodeElimination)) {
+                Optimization::DeadCodeElimination(ir_block);
+            }
+            if (config.HasOptimization(OptimizationFlag::ConstantMemoryReads)) {
+                Optimization::A32ConstantMemoryReads(ir_block, config.callbacks);
+            }
+            if (config.HasOptimization(OptimizationFlag::ConstantPropagation)) {
+                Optimization::ConstantPropagation(ir_block);
+            }
+            if (config.HasOptimization(OptimizationFlag::DeadCodeElimination)) {
+                Optimization::DeadCodeElimination(ir_block);
+            }
+            if (config.HasOptimization(OptimizationFlag::MergeInterpretBlocks)) {
+                Optimization::A32MergeInterpretBlocksPass(ir_block, config.callbacks);
+            }
+        }
+        if (config.HasOptimization(OptimizationFlag::Verification)) {
+            Optimization::VerificationPass(ir_block);
         }
-        Optimization::VerificationPass(ir_block);
         return emitter.Emit(ir_block);
     }
 };
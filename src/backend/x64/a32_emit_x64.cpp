@@ -20,6 +20,7 @@
 #include "backend/x64/emit_x64.h"
 #include "backend/x64/nzcv_util.h"
 #include "backend/x64/perf_map.h"
+#include "backend/x64/software_tlb.h"
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/common_types.h"
@@ -73,9 +74,21 @@ FP::FPCR A32EmitContext::FPCR() const {
     return FP::FPCR{Location().FPSCR().Value()};
 }
 
+static std::vector<HostLoc> GprOrder(const A32::UserConfig& conf) {
+    std::vector<HostLoc> gprs{any_gpr};
+    if (conf.page_table) {
+        gprs.erase(std::find(gprs.begin(), gprs.end(), HostLoc::R14));
+    }
+    if (conf.fastmem_pointer || conf.flat_memory_base) {
+        gprs.erase(std::find(gprs.begin(), gprs.end(), HostLoc::R13));
+    }
+    return gprs;
+}
+
 A32EmitX64::A32EmitX64(BlockOfCode& code, A32::UserConfig conf, A32::Jit* jit_interface)
-    : EmitX64(code), conf(std::move(conf)), jit_interface(jit_interface) {
-    GenFastmemFallbacks();
+    : EmitX64(code), conf(std::move(conf)), jit_interface(jit_interface),
+      gpr_order(GprOrder(this->conf)),
+      reg_alloc{code, A32JitState::SpillCount, SpillToOpArg<A32JitState>, gpr_order, any_xmm} {
     GenTerminalHandlers();
     code.PreludeComplete();
     ClearFastDispatchTable();
@@ -91,21 +104,11 @@ A32EmitX64::BlockDescriptor A32EmitX64::Emit(IR::Block& block) {
         code.DisableWriting();
     };
 
-    static const std::vector<HostLoc> gpr_order = [this] {
-        std::vector<HostLoc> gprs{any_gpr};
-        if (conf.page_table) {
-            gprs.erase(std::find(gprs.begin(), gprs.end(), HostLoc::R14));
-        }
-        if (conf.fastmem_pointer) {
-            gprs.erase(std::find(gprs.begin(), gprs.end(), HostLoc::R13));
-        }
-        return gprs;
-    }();
-
-    RegAlloc reg_alloc{code, A32JitState::SpillCount, SpillToOpArg<A32JitState>, gpr_order,
-                       any_xmm};
+    reg_alloc.Reset(gpr_order);
     A32EmitContext ctx{reg_alloc, block};
 
+    reg_alloc.AnalyzeUses(block);
+
     // Start emitting.
     code.align();
     const u8* const entrypoint = code.getCurr();
@@ -115,6 +118,11 @@ A32EmitX64::BlockDescriptor A32EmitX64::Emit(IR::Block& block) {
     for (auto iter = block.begin(); iter != block.end(); ++iter) {
         IR::Inst* inst = &*iter;
 
+        reg_alloc.BeginInstruction(inst);
+        if (!PreservesHostFlags(inst->GetOpcode())) {
+            reg_alloc.ClobberHostFlags();
+        }
+
         // Call the relevant Emit* member function.
         switch (inst->GetOpcode()) {
 
@@ -155,6 +163,11 @@ A32EmitX64::BlockDescriptor A32EmitX64::Emit(IR::Block& block) {
     const auto range =
         boost::icl::discrete_interval<u32>::closed(descriptor.PC(), end_location.PC() - 1);
     block_ranges.AddRange(range, descriptor);
+    for (const auto& [start, end] : block.CodeDependencies()) {
+        const auto dependency_range = boost::icl::discrete_interval<u32>::closed(
+            A32::LocationDescriptor{start}.PC(), A32::LocationDescriptor{end}.PC() - 1);
+        block_ranges.AddRange(dependency_range, descriptor);
+    }
 
     return RegisterBlock(descriptor, entrypoint, size);
 }
@@ -191,70 +204,121 @@ void A32EmitX64::ClearFastDispatchTable() {
     }
 }
 
-void A32EmitX64::GenFastmemFallbacks() {
-    const std::initializer_list<int> idxes{0, 1, 2, 3, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
-    const std::array<std::pair<size_t, ArgCallback>, 4> read_callbacks{{
-        {8, Devirtualize<&A32::UserCallbacks::MemoryRead8>(conf.callbacks)},
-        {16, Devirtualize<&A32::UserCallbacks::MemoryRead16>(conf.callbacks)},
-        {32, Devirtualize<&A32::UserCallbacks::MemoryRead32>(conf.callbacks)},
-        {64, Devirtualize<&A32::UserCallbacks::MemoryRead64>(conf.callbacks)},
-    }};
-    const std::array<std::pair<size_t, ArgCallback>, 4> write_callbacks{{
-        {8, Devirtualize<&A32::UserCallbacks::MemoryWrite8>(conf.callbacks)},
-        {16, Devirtualize<&A32::UserCallbacks::MemoryWrite16>(conf.callbacks)},
-        {32, Devirtualize<&A32::UserCallbacks::MemoryWrite32>(conf.callbacks)},
-        {64, Devirtualize<&A32::UserCallbacks::MemoryWrite64>(conf.callbacks)},
-    }};
-
-    for (int vaddr_idx : idxes) {
-        for (int value_idx : idxes) {
-            for (const auto& [bitsize, callback] : read_callbacks) {
-                code.align();
-                read_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)] =
-                    code.getCurr<void (*)()>();
-                ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
-                if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
-                    code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-                }
-                callback.EmitCall(code);
-                if (value_idx != code.ABI_RETURN.getIdx()) {
-                    code.mov(Xbyak::Reg64{value_idx}, code.ABI_RETURN);
-                }
-                ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
-                code.ret();
-                PerfMapRegister(read_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)],
-                                code.getCurr(), fmt::format("a32_read_fallback_{}", bitsize));
-            }
-
-            for (const auto& [bitsize, callback] : write_callbacks) {
-                code.align();
-                write_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)] =
-                    code.getCurr<void (*)()>();
-                ABI_PushCallerSaveRegistersAndAdjustStack(code);
-                if (vaddr_idx == code.ABI_PARAM3.getIdx() &&
-                    value_idx == code.ABI_PARAM2.getIdx()) {
-                    code.xchg(code.ABI_PARAM2, code.ABI_PARAM3);
-                } else if (vaddr_idx == code.ABI_PARAM3.getIdx()) {
-                    code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-                    if (value_idx != code.ABI_PARAM3.getIdx()) {
-                        code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
-                    }
-                } else {
-                    if (value_idx != code.ABI_PARAM3.getIdx()) {
-                        code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
-                    }
-                    if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
-                        code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-                    }
-                }
-                callback.EmitCall(code);
-                ABI_PopCallerSaveRegistersAndAdjustStack(code);
-                code.ret();
-                PerfMapRegister(write_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)],
-                                code.getCurr(), fmt::format("a32_write_fallback_{}", bitsize));
-            }
+namespace {
+
+template <auto callback>
+ArgCallback ReadCallback(A32::UserCallbacks* cb, bool software_tlb) {
+    return software_tlb ? SoftwareTLBRead<callback>(cb) : Devirtualize<callback>(cb);
+}
+
+template <auto callback>
+ArgCallback WriteCallback(A32::UserCallbacks* cb, bool software_tlb) {
+    return software_tlb ? SoftwareTLBWrite<callback>(cb) : Devirtualize<callback>(cb);
+}
+
+} // anonymous namespace
+
+A32EmitX64::FallbackFn A32EmitX64::GetReadFallback(size_t bitsize, int vaddr_idx,
+                                                   int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    if (read_fallbacks.count(key) == 0) {
+        code.GenerateThunk([&] { GenReadFallback(bitsize, vaddr_idx, value_idx); });
+    }
+    return read_fallbacks.at(key);
+}
+
+A32EmitX64::FallbackFn A32EmitX64::GetWriteFallback(size_t bitsize, int vaddr_idx,
+                                                    int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    if (write_fallbacks.count(key) == 0) {
+        code.GenerateThunk([&] { GenWriteFallback(bitsize, vaddr_idx, value_idx); });
+    }
+    return write_fallbacks.at(key);
+}
+
+void A32EmitX64::GenReadFallback(size_t bitsize, int vaddr_idx, int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    const bool software_tlb = UseSoftwareTLB();
+
+    const ArgCallback callback = [&] {
+        switch (bitsize) {
+        case 8:
+            return ReadCallback<&A32::UserCallbacks::MemoryRead8>(conf.callbacks, software_tlb);
+        case 16:
+            return ReadCallback<&A32::UserCallbacks::MemoryRead16>(conf.callbacks, software_tlb);
+        case 32:
+            return ReadCallback<&A32::UserCallbacks::MemoryRead32>(conf.callbacks, software_tlb);
+        default:
+            ASSERT(bitsize == 64);
+            return ReadCallback<&A32::UserCallbacks::MemoryRead64>(conf.callbacks, software_tlb);
+        }
+    }();
+
+    code.align();
+    read_fallbacks[key] = code.getCurr<FallbackFn>();
+    ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
+    if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
+        code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
+    }
+    callback.EmitCall(code, [&](RegList param) {
+        if (software_tlb) {
+            code.lea(param[1], ptr[r15 + offsetof(A32JitState, tlb)]);
+        }
+    });
+    if (value_idx != code.ABI_RETURN.getIdx()) {
+        code.mov(Xbyak::Reg64{value_idx}, code.ABI_RETURN);
+    }
+    ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
+    code.ret();
+    PerfMapRegister(read_fallbacks[key], code.getCurr(),
+                    fmt::format("a32_read_fallback_{}", bitsize));
+}
+
+void A32EmitX64::GenWriteFallback(size_t bitsize, int vaddr_idx, int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    const bool software_tlb = UseSoftwareTLB();
+
+    const ArgCallback callback = [&] {
+        switch (bitsize) {
+        case 8:
+            return WriteCallback<&A32::UserCallbacks::MemoryWrite8>(conf.callbacks, software_tlb);
+        case 16:
+            return WriteCallback<&A32::UserCallbacks::MemoryWrite16>(conf.callbacks, software_tlb);
+        case 32:
+            return WriteCallback<&A32::UserCallbacks::MemoryWrite32>(conf.callbacks, software_tlb);
+        default:
+            ASSERT(bitsize == 64);
+            return WriteCallback<&A32::UserCallbacks::MemoryWrite64>(conf.callbacks, software_tlb);
+        }
+    }();
+
+    code.align();
+    write_fallbacks[key] = code.getCurr<FallbackFn>();
+    ABI_PushCallerSaveRegistersAndAdjustStack(code);
+    if (vaddr_idx == code.ABI_PARAM3.getIdx() && value_idx == code.ABI_PARAM2.getIdx()) {
+        code.xchg(code.ABI_PARAM2, code.ABI_PARAM3);
+    } else if (vaddr_idx == code.ABI_PARAM3.getIdx()) {
+        code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
+        if (value_idx != code.ABI_PARAM3.getIdx()) {
+            code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
+        }
+    } else {
+        if (value_idx != code.ABI_PARAM3.getIdx()) {
+            code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
+        }
+        if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
+            code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
         }
     }
+    callback.EmitCall(code, [&](RegList param) {
+        if (software_tlb) {
+            code.lea(param[2], ptr[r15 + offsetof(A32JitState, tlb)]);
+        }
+    });
+    ABI_PopCallerSaveRegistersAndAdjustStack(code);
+    code.ret();
+    PerfMapRegister(write_fallbacks[key], code.getCurr(),
+                    fmt::format("a32_write_fallback_{}", bitsize));
 }
 
 void A32EmitX64::GenTerminalHandlers() {
@@ -888,7 +952,7 @@ void A32EmitX64::EmitA32SetExclusive(A32EmitContext& ctx, IR::Inst* inst) {
 
 std::optional<A32EmitX64::DoNotFastmemMarker> A32EmitX64::ShouldFastmem(A32EmitContext& ctx,
                                                                         IR::Inst* inst) const {
-    if (!conf.fastmem_pointer || !exception_handler.SupportsFastmem()) {
+    if (!conf.page_table || !conf.fastmem_pointer || !exception_handler.SupportsFastmem()) {
         return std::nullopt;
     }
 
@@ -899,6 +963,10 @@ std::optional<A32EmitX64::DoNotFastmemMarker> A32EmitX64::ShouldFastmem(A32EmitC
     return marker;
 }
 
+bool A32EmitX64::UseSoftwareTLB() const {
+    return !conf.page_table && !conf.flat_memory_base && conf.enable_software_tlb;
+}
+
 FakeCall A32EmitX64::FastmemCallback(u64 rip_) {
     const auto iter = fastmem_patch_info.find(rip_);
     ASSERT(iter != fastmem_patch_info.end());
@@ -934,6 +1002,16 @@ static Xbyak::RegExp EmitVAddrLookup(BlockOfCode& code, RegAlloc& reg_alloc,
     return page + tmp;
 }
 
+/// Paired accesses are checked as a whole so that the host never accesses past the end of a page.
+static void EmitDetectPageCrossingVAddr(BlockOfCode& code, size_t bytes, Xbyak::Label& abort,
+                                        Xbyak::Reg64 vaddr, Xbyak::Reg64 tmp) {
+    constexpr size_t page_size = size_t(1) << A32::UserConfig::PAGE_BITS;
+    code.mov(tmp.cvt32(), vaddr.cvt32());
+    code.and_(tmp.cvt32(), static_cast<u32>(page_size - 1));
+    code.cmp(tmp.cvt32(), static_cast<u32>(page_size - bytes));
+    code.ja(abort);
+}
+
 template <std::size_t bitsize>
 static void EmitReadMemoryMov(BlockOfCode& code, const Xbyak::Reg64& value,
                               const Xbyak::RegExp& addr) {
@@ -976,11 +1054,31 @@ static void EmitWriteMemoryMov(BlockOfCode& code, const Xbyak::RegExp& addr,
     }
 }
 
+static Xbyak::RegExp EmitFlatMemoryLookup(BlockOfCode& code, RegAlloc& reg_alloc,
+                                          const A32::UserConfig& conf, Xbyak::Reg64 vaddr) {
+    if (conf.flat_memory_mask == 0xFFFFFFFF) {
+        return r13 + vaddr;
+    }
+    const Xbyak::Reg64 tmp = reg_alloc.ScratchGpr();
+    code.mov(tmp.cvt32(), vaddr.cvt32());
+    code.and_(tmp.cvt32(), conf.flat_memory_mask);
+    return r13 + tmp;
+}
+
 template <std::size_t bitsize, auto callback>
 void A32EmitX64::ReadMemory(A32EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
 
-    if (!conf.page_table) {
+    if (conf.flat_memory_base) {
+        const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+        const Xbyak::Reg64 value = ctx.reg_alloc.ScratchGpr();
+        EmitReadMemoryMov<bitsize>(code, value,
+                                   EmitFlatMemoryLookup(code, ctx.reg_alloc, conf, vaddr));
+        ctx.reg_alloc.DefineValue(inst, value);
+        return;
+    }
+
+    if (!conf.page_table && !UseSoftwareTLB()) {
         ctx.reg_alloc.HostCall(inst, {}, args[0]);
         Devirtualize<callback>(conf.callbacks).EmitCall(code);
         return;
@@ -989,8 +1087,7 @@ void A32EmitX64::ReadMemory(A32EmitContext& ctx, IR::Inst* inst) {
     const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
     const Xbyak::Reg64 value = ctx.reg_alloc.ScratchGpr();
 
-    const auto wrapped_fn =
-        read_fallbacks[std::make_tuple(bitsize, vaddr.getIdx(), value.getIdx())];
+    const auto wrapped_fn = GetReadFallback(bitsize, vaddr.getIdx(), value.getIdx());
 
     if (const auto marker = ShouldFastmem(ctx, inst)) {
         const auto location = code.getCurr();
@@ -1009,7 +1106,11 @@ void A32EmitX64::ReadMemory(A32EmitContext& ctx, IR::Inst* inst) {
 
     Xbyak::Label abort, end;
 
-    const auto src_ptr = EmitVAddrLookup(code, ctx.reg_alloc, conf, abort, vaddr, value);
+    const auto src_ptr =
+        UseSoftwareTLB()
+            ? EmitSoftwareTLBLookup(code, ctx.reg_alloc, offsetof(A32JitState, tlb), bitsize, abort,
+                                    vaddr, value)
+            : EmitVAddrLookup(code, ctx.reg_alloc, conf, abort, vaddr, value);
     EmitReadMemoryMov<bitsize>(code, value, src_ptr);
     code.jmp(end);
     code.L(abort);
@@ -1023,7 +1124,15 @@ template <std::size_t bitsize, auto callback>
 void A32EmitX64::WriteMemory(A32EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
 
-    if (!conf.page_table) {
+    if (conf.flat_memory_base) {
+        const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+        const Xbyak::Reg64 value = ctx.reg_alloc.UseGpr(args[1]);
+        EmitWriteMemoryMov<bitsize>(code, EmitFlatMemoryLookup(code, ctx.reg_alloc, conf, vaddr),
+                                    value);
+        return;
+    }
+
+    if (!conf.page_table && !UseSoftwareTLB()) {
         ctx.reg_alloc.HostCall(nullptr, {}, args[0], args[1]);
         Devirtualize<callback>(conf.callbacks).EmitCall(code);
         return;
@@ -1032,8 +1141,7 @@ void A32EmitX64::WriteMemory(A32EmitContext& ctx, IR::Inst* inst) {
     const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
     const Xbyak::Reg64 value = ctx.reg_alloc.UseGpr(args[1]);
 
-    const auto wrapped_fn =
-        write_fallbacks[std::make_tuple(bitsize, vaddr.getIdx(), value.getIdx())];
+    const auto wrapped_fn = GetWriteFallback(bitsize, vaddr.getIdx(), value.getIdx());
 
     if (const auto marker = ShouldFastmem(ctx, inst)) {
         const auto location = code.getCurr();
@@ -1051,7 +1159,11 @@ void A32EmitX64::WriteMemory(A32EmitContext& ctx, IR::Inst* inst) {
 
     Xbyak::Label abort, end;
 
-    const auto dest_ptr = EmitVAddrLookup(code, ctx.reg_alloc, conf, abort, vaddr);
+    const auto dest_ptr =
+        UseSoftwareTLB()
+            ? EmitSoftwareTLBLookup(code, ctx.reg_alloc, offsetof(A32JitState, tlb), bitsize, abort,
+                                    vaddr)
+            : EmitVAddrLookup(code, ctx.reg_alloc, conf, abort, vaddr);
     EmitWriteMemoryMov<bitsize>(code, dest_ptr, value);
     code.jmp(end);
     code.L(abort);
@@ -1091,6 +1203,80 @@ void A32EmitX64::EmitA32WriteMemory64(A32EmitContext& ctx, IR::Inst* inst) {
     WriteMemory<64, &A32::UserCallbacks::MemoryWrite64>(ctx, inst);
 }
 
+void A32EmitX64::EmitA32ReadMemoryPair32(A32EmitContext& ctx, IR::Inst* inst) {
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 value = ctx.reg_alloc.ScratchGpr();
+
+    if (conf.flat_memory_base) {
+        EmitReadMemoryMov<64>(code, value, EmitFlatMemoryLookup(code, ctx.reg_alloc, conf, vaddr));
+        ctx.reg_alloc.DefineValue(inst, value);
+        return;
+    }
+
+    ASSERT(conf.page_table || UseSoftwareTLB());
+
+    const Xbyak::Reg64 tmp = ctx.reg_alloc.ScratchGpr();
+    Xbyak::Label abort, end;
+
+    if (!UseSoftwareTLB()) {
+        EmitDetectPageCrossingVAddr(code, 8, abort, vaddr, tmp);
+    }
+    const auto src_ptr =
+        UseSoftwareTLB()
+            ? EmitSoftwareTLBLookup(code, ctx.reg_alloc, offsetof(A32JitState, tlb), 64, abort,
+                                    vaddr, tmp)
+            : EmitVAddrLookup(code, ctx.reg_alloc, conf, abort, vaddr, tmp);
+    EmitReadMemoryMov<64>(code, value, src_ptr);
+    code.jmp(end);
+    code.L(abort);
+    code.call(GetReadFallback(32, vaddr.getIdx(), value.getIdx()));
+    code.mov(value.cvt32(), value.cvt32());
+    code.lea(tmp.cvt32(), ptr[vaddr + 4]);
+    code.call(GetReadFallback(32, tmp.getIdx(), tmp.getIdx()));
+    code.shl(tmp, 32);
+    code.or_(value, tmp);
+    code.L(end);
+
+    ctx.reg_alloc.DefineValue(inst, value);
+}
+
+void A32EmitX64::EmitA32WriteMemoryPair32(A32EmitContext& ctx, IR::Inst* inst) {
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 value1 = ctx.reg_alloc.UseGpr(args[1]);
+    const Xbyak::Reg64 value2 = ctx.reg_alloc.UseGpr(args[2]);
+
+    if (conf.flat_memory_base) {
+        const auto dest_ptr = EmitFlatMemoryLookup(code, ctx.reg_alloc, conf, vaddr);
+        EmitWriteMemoryMov<32>(code, dest_ptr, value1);
+        EmitWriteMemoryMov<32>(code, dest_ptr + 4, value2);
+        return;
+    }
+
+    ASSERT(conf.page_table || UseSoftwareTLB());
+
+    const Xbyak::Reg64 tmp = ctx.reg_alloc.ScratchGpr();
+    Xbyak::Label abort, end;
+
+    if (!UseSoftwareTLB()) {
+        EmitDetectPageCrossingVAddr(code, 8, abort, vaddr, tmp);
+    }
+    const auto dest_ptr =
+        UseSoftwareTLB()
+            ? EmitSoftwareTLBLookup(code, ctx.reg_alloc, offsetof(A32JitState, tlb), 64, abort,
+                                    vaddr, tmp)
+            : EmitVAddrLookup(code, ctx.reg_alloc, conf, abort, vaddr, tmp);
+    EmitWriteMemoryMov<32>(code, dest_ptr, value1);
+    EmitWriteMemoryMov<32>(code, dest_ptr + 4, value2);
+    code.jmp(end);
+    code.L(abort);
+    code.call(GetWriteFallback(32, vaddr.getIdx(), value1.getIdx()));
+    code.lea(tmp.cvt32(), ptr[vaddr + 4]);
+    code.call(GetWriteFallback(32, tmp.getIdx(), value2.getIdx()));
+    code.L(end);
+}
+
 template <size_t bitsize, auto callback>
 void A32EmitX64::ExclusiveWriteMemory(A32EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
@@ -1422,10 +1608,9 @@ void A32EmitX64::EmitTerminalImpl(IR::Term::Interpret terminal,
     ASSERT_MSG(A32::LocationDescriptor{terminal.next}.EFlag() ==
                    A32::LocationDescriptor{initial_location}.EFlag(),
                "Unimplemented");
-    ASSERT_MSG(terminal.num_instructions == 1, "Unimplemented");
 
     code.mov(code.ABI_PARAM2.cvt32(), A32::LocationDescriptor{terminal.next}.PC());
-    code.mov(code.ABI_PARAM3.cvt32(), 1);
+    code.mov(code.ABI_PARAM3.cvt32(), terminal.num_instructions);
     code.mov(MJitStateReg(A32::Reg::PC), code.ABI_PARAM2.cvt32());
     code.SwitchMxcsrOnExit();
     Devirtualize<&A32::UserCallbacks::InterpreterFallback>(conf.callbacks).EmitCall(code);
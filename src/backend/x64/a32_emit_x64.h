@@ -52,6 +52,11 @@ protected:
     A32::Jit* jit_interface;
     BlockRangeInformation<u32> block_ranges;
 
+    /// General-purpose registers available to the register allocator.
+    const std::vector<HostLoc> gpr_order;
+    /// Kept across blocks so that its storage is reused rather than reallocated for each block.
+    RegAlloc reg_alloc;
+
     void EmitCondPrelude(const A32EmitContext& ctx);
 
     struct FastDispatchEntry {
@@ -64,9 +69,14 @@ protected:
     std::array<FastDispatchEntry, fast_dispatch_table_size> fast_dispatch_table;
     void ClearFastDispatchTable();
 
-    std::map<std::tuple<size_t, int, int>, void (*)()> read_fallbacks;
-    std::map<std::tuple<size_t, int, int>, void (*)()> write_fallbacks;
-    void GenFastmemFallbacks();
+    // Fallbacks are keyed by (bitsize, vaddr_idx, value_idx), and are generated on first use.
+    using FallbackFn = void (*)();
+    std::map<std::tuple<size_t, int, int>, FallbackFn> read_fallbacks;
+    std::map<std::tuple<size_t, int, int>, FallbackFn> write_fallbacks;
+    FallbackFn GetReadFallback(size_t bitsize, int vaddr_idx, int value_idx);
+    FallbackFn GetWriteFallback(size_t bitsize, int vaddr_idx, int value_idx);
+    void GenReadFallback(size_t bitsize, int vaddr_idx, int value_idx);
+    void GenWriteFallback(size_t bitsize, int vaddr_idx, int value_idx);
 
     const void* terminal_handler_pop_rsb_hint;
     const void* terminal_handler_fast_dispatch_hint = nullptr;
@@ -98,6 +108,7 @@ protected:
     FakeCall FastmemCallback(u64 rip);
 
     // Memory access helpers
+    bool UseSoftwareTLB() const;
     template <std::size_t bitsize, auto callback>
     void ReadMemory(A32EmitContext& ctx, IR::Inst* inst);
     template <std::size_t bitsize, auto callback>
@@ -21,9 +21,12 @@
 #include "common/assert.h"
 #include "common/cast_util.h"
 #include "common/common_types.h"
+#include "common/fp/fpcr.h"
 #include "common/llvm_disassemble.h"
 #include "common/scope_exit.h"
+#include "frontend/A32/location_descriptor.h"
 #include "frontend/A32/translate/translate.h"
+#include "frontend/code_reader.h"
 #include "frontend/ir/basic_block.h"
 #include "frontend/ir/location_descriptor.h"
 #include "ir_opt/passes.h"
@@ -47,7 +50,9 @@ static std::function<void(BlockOfCode&)> GenRCP(const A32::UserConfig& conf) {
         if (conf.page_table) {
             code.mov(code.r14, Common::BitCast<u64>(conf.page_table));
         }
-        if (conf.fastmem_pointer) {
+        if (conf.flat_memory_base) {
+            code.mov(code.r13, Common::BitCast<u64>(conf.flat_memory_base));
+        } else if (conf.fastmem_pointer) {
             code.mov(code.r13, Common::BitCast<u64>(conf.fastmem_pointer));
         }
     };
@@ -163,16 +168,9 @@ private:
 
         IR::Block ir_block =
             A32::Translate(A32::LocationDescriptor{descriptor},
-                           [this](u32 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); },
+                           CodeReader<UserCallbacks, u32>{conf.callbacks},
                            {conf.define_unpredictable_behaviour, conf.hook_hint_instructions});
-        if (conf.enable_optimizations) {
-            Optimization::A32GetSetElimination(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-            Optimization::A32ConstantMemoryReads(ir_block, conf.callbacks);
-            Optimization::ConstantPropagation(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-        }
-        Optimization::VerificationPass(ir_block);
+        Optimization::A32Optimize(ir_block, conf);
         return emitter.Emit(ir_block);
     }
 };
@@ -229,6 +227,10 @@ void Jit::HaltExecution() {
     impl->jit_state.halt_requested = true;
 }
 
+void Jit::FlushSoftwareTLB() {
+    impl->jit_state.tlb.Flush();
+}
+
 std::array<u32, 16>& Jit::Regs() {
     return impl->jit_state.Reg;
 }
@@ -9,6 +9,7 @@
 
 #include <xbyak/xbyak.h>
 
+#include "backend/x64/software_tlb.h"
 #include "common/common_types.h"
 
 namespace Dynarmic::Backend::X64 {
@@ -74,6 +75,9 @@ struct A32JitState {
     u32 Fpscr() const;
     void SetFpscr(u32 FPSCR);
 
+    // Software TLB (See: UserConfig::enable_software_tlb)
+    SoftwareTLB tlb;
+
     u64 GetUniqueHash() const noexcept {
         return (static_cast<u64>(upper_location_descriptor) << 32) | (static_cast<u64>(Reg[15]));
     }
@@ -3,7 +3,11 @@
  * SPDX-License-Identifier: 0BSD
  */
 
-#include <initializer_list>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 #include <dynarmic/A64/exclusive_monitor.h>
 #include <fmt/format.h>
@@ -17,6 +21,7 @@
 #include "backend/x64/emit_x64.h"
 #include "backend/x64/nzcv_util.h"
 #include "backend/x64/perf_map.h"
+#include "backend/x64/software_tlb.h"
 #include "common/assert.h"
 #include "common/bit_util.h"
 #include "common/common_types.h"
@@ -55,9 +60,9 @@ bool A64EmitContext::AccurateNaN() const {
 }
 
 A64EmitX64::A64EmitX64(BlockOfCode& code, A64::UserConfig conf, A64::Jit* jit_interface)
-    : EmitX64(code), conf(conf), jit_interface{jit_interface} {
+    : EmitX64(code), conf(conf), jit_interface{jit_interface},
+      reg_alloc{code, A64JitState::SpillCount, SpillToOpArg<A64JitState>, any_gpr, any_xmm} {
     GenMemory128Accessors();
-    GenFastmemFallbacks();
     GenTerminalHandlers();
     code.PreludeComplete();
     ClearFastDispatchTable();
@@ -71,18 +76,44 @@ A64EmitX64::BlockDescriptor A64EmitX64::Emit(IR::Block& block) {
         code.DisableWriting();
     };
 
-    RegAlloc reg_alloc{code, A64JitState::SpillCount, SpillToOpArg<A64JitState>, any_gpr, any_xmm};
+    const bool is_self_loop = IsSelfLoop(block);
+    if (is_self_loop) {
+        loop_registers = ChooseLoopRegisters(block);
+    }
+    SCOPE_EXIT {
+        loop_registers.clear();
+    };
+
+    gpr_order.assign(any_gpr.begin(), any_gpr.end());
+    if (conf.flat_memory_base) {
+        gpr_order.erase(std::find(gpr_order.begin(), gpr_order.end(), HostLoc::R13));
+    }
+    for (const auto& [reg, host_loc] : loop_registers) {
+        gpr_order.erase(std::find(gpr_order.begin(), gpr_order.end(), host_loc));
+    }
+
+    reg_alloc.Reset(gpr_order);
     A64EmitContext ctx{conf, reg_alloc, block};
 
+    reg_alloc.AnalyzeUses(block);
+
     // Start emitting.
     code.align();
     const u8* const entrypoint = code.getCurr();
 
     ASSERT(block.GetCondition() == IR::Cond::AL);
 
+    EmitLoadLoopRegisters();
+    const u8* const loop_head = code.getCurr();
+
     for (auto iter = block.begin(); iter != block.end(); ++iter) {
         IR::Inst* inst = &*iter;
 
+        reg_alloc.BeginInstruction(inst);
+        if (!PreservesHostFlags(inst->GetOpcode())) {
+            reg_alloc.ClobberHostFlags();
+        }
+
         // Call the relevant Emit* member function.
         switch (inst->GetOpcode()) {
 
@@ -110,9 +141,20 @@ A64EmitX64::BlockDescriptor A64EmitX64::Emit(IR::Block& block) {
 
     reg_alloc.AssertNoMoreUses();
 
-    EmitAddCycles(block.CycleCount());
-    EmitX64::EmitTerminal(block.GetTerminal(), ctx.Location().SetSingleStepping(false),
-                          ctx.IsSingleStep());
+    // A conditional terminal can branch on the flags left behind by the final flag-setting
+    // instruction instead of reloading them from the guest state.
+    const IR::Terminal terminal = block.GetTerminal();
+    terminal_nzcv_in_host_flags =
+        reg_alloc.IsGuestNZCVInHostFlags() && boost::get<IR::Term::If>(&terminal) != nullptr;
+
+    EmitAddCycles(block.CycleCount(), terminal_nzcv_in_host_flags);
+    if (is_self_loop) {
+        EmitSelfLoopTerminal(terminal, ctx.Location().SetSingleStepping(false), loop_head);
+    } else {
+        EmitX64::EmitTerminal(terminal, ctx.Location().SetSingleStepping(false),
+                              ctx.IsSingleStep());
+    }
+    terminal_nzcv_in_host_flags = false;
     code.int3();
 
     const size_t size = static_cast<size_t>(code.getCurr() - entrypoint);
@@ -123,6 +165,11 @@ A64EmitX64::BlockDescriptor A64EmitX64::Emit(IR::Block& block) {
     const auto range =
         boost::icl::discrete_interval<u64>::closed(descriptor.PC(), end_location.PC() - 1);
     block_ranges.AddRange(range, descriptor);
+    for (const auto& [start, end] : block.CodeDependencies()) {
+        const auto dependency_range = boost::icl::discrete_interval<u64>::closed(
+            A64::LocationDescriptor{start}.PC(), A64::LocationDescriptor{end}.PC() - 1);
+        block_ranges.AddRange(dependency_range, descriptor);
+    }
 
     return RegisterBlock(descriptor, entrypoint, size);
 }
@@ -197,109 +244,153 @@ void A64EmitX64::GenMemory128Accessors() {
     PerfMapRegister(memory_read_128, code.getCurr(), "a64_memory_write_128");
 }
 
-void A64EmitX64::GenFastmemFallbacks() {
-    const std::initializer_list<int> idxes{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
-    const std::array<std::pair<size_t, ArgCallback>, 4> read_callbacks{{
-        {8, Devirtualize<&A64::UserCallbacks::MemoryRead8>(conf.callbacks)},
-        {16, Devirtualize<&A64::UserCallbacks::MemoryRead16>(conf.callbacks)},
-        {32, Devirtualize<&A64::UserCallbacks::MemoryRead32>(conf.callbacks)},
-        {64, Devirtualize<&A64::UserCallbacks::MemoryRead64>(conf.callbacks)},
-    }};
-    const std::array<std::pair<size_t, ArgCallback>, 4> write_callbacks{{
-        {8, Devirtualize<&A64::UserCallbacks::MemoryWrite8>(conf.callbacks)},
-        {16, Devirtualize<&A64::UserCallbacks::MemoryWrite16>(conf.callbacks)},
-        {32, Devirtualize<&A64::UserCallbacks::MemoryWrite32>(conf.callbacks)},
-        {64, Devirtualize<&A64::UserCallbacks::MemoryWrite64>(conf.callbacks)},
-    }};
-
-    for (int vaddr_idx : idxes) {
-        if (vaddr_idx == 4 || vaddr_idx == 15) {
-            continue;
+namespace {
+
+template <auto callback>
+ArgCallback ReadCallback(A64::UserCallbacks* cb, bool software_tlb) {
+    return software_tlb ? SoftwareTLBRead<callback>(cb) : Devirtualize<callback>(cb);
+}
+
+template <auto callback>
+ArgCallback WriteCallback(A64::UserCallbacks* cb, bool software_tlb) {
+    return software_tlb ? SoftwareTLBWrite<callback>(cb) : Devirtualize<callback>(cb);
+}
+
+} // anonymous namespace
+
+A64EmitX64::FallbackFn A64EmitX64::GetReadFallback(size_t bitsize, int vaddr_idx,
+                                                   int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    if (read_fallbacks.count(key) == 0) {
+        code.GenerateThunk([&] { GenReadFallback(bitsize, vaddr_idx, value_idx); });
+    }
+    return read_fallbacks.at(key);
+}
+
+A64EmitX64::FallbackFn A64EmitX64::GetWriteFallback(size_t bitsize, int vaddr_idx,
+                                                    int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    if (write_fallbacks.count(key) == 0) {
+        code.GenerateThunk([&] { GenWriteFallback(bitsize, vaddr_idx, value_idx); });
+    }
+    return write_fallbacks.at(key);
+}
+
+void A64EmitX64::GenReadFallback(size_t bitsize, int vaddr_idx, int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    const bool software_tlb = UseSoftwareTLB();
+
+    code.align();
+    read_fallbacks[key] = code.getCurr<FallbackFn>();
+
+    if (bitsize == 128) {
+        ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLocXmmIdx(value_idx));
+        if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
+            code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
+        }
+        code.call(memory_read_128);
+        if (value_idx != 1) {
+            code.movaps(Xbyak::Xmm{value_idx}, xmm1);
+        }
+        ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLocXmmIdx(value_idx));
+        code.ret();
+        PerfMapRegister(read_fallbacks[key], code.getCurr(), "a64_read_fallback_128");
+        return;
+    }
+
+    const ArgCallback callback = [&] {
+        switch (bitsize) {
+        case 8:
+            return ReadCallback<&A64::UserCallbacks::MemoryRead8>(conf.callbacks, software_tlb);
+        case 16:
+            return ReadCallback<&A64::UserCallbacks::MemoryRead16>(conf.callbacks, software_tlb);
+        case 32:
+            return ReadCallback<&A64::UserCallbacks::MemoryRead32>(conf.callbacks, software_tlb);
+        default:
+            ASSERT(bitsize == 64);
+            return ReadCallback<&A64::UserCallbacks::MemoryRead64>(conf.callbacks, software_tlb);
         }
+    }();
 
-        for (int value_idx : idxes) {
-            code.align();
-            read_fallbacks[std::make_tuple(128, vaddr_idx, value_idx)] = code.getCurr<void (*)()>();
-            ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLocXmmIdx(value_idx));
-            if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
-                code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-            }
-            code.call(memory_read_128);
-            if (value_idx != 1) {
-                code.movaps(Xbyak::Xmm{value_idx}, xmm1);
-            }
-            ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLocXmmIdx(value_idx));
-            code.ret();
-            PerfMapRegister(read_fallbacks[std::make_tuple(128, vaddr_idx, value_idx)],
-                            code.getCurr(), "a64_read_fallback_128");
-
-            code.align();
-            write_fallbacks[std::make_tuple(128, vaddr_idx, value_idx)] =
-                code.getCurr<void (*)()>();
-            ABI_PushCallerSaveRegistersAndAdjustStack(code);
-            if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
-                code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-            }
-            if (value_idx != 1) {
-                code.movaps(xmm1, Xbyak::Xmm{value_idx});
-            }
-            code.call(memory_write_128);
-            ABI_PopCallerSaveRegistersAndAdjustStack(code);
-            code.ret();
-            PerfMapRegister(write_fallbacks[std::make_tuple(128, vaddr_idx, value_idx)],
-                            code.getCurr(), "a64_write_fallback_128");
-
-            if (value_idx == 4 || value_idx == 15) {
-                continue;
-            }
+    ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
+    if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
+        code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
+    }
+    callback.EmitCall(code, [&](RegList param) {
+        if (software_tlb) {
+            code.lea(param[1], ptr[r15 + offsetof(A64JitState, tlb)]);
+        }
+    });
+    if (value_idx != code.ABI_RETURN.getIdx()) {
+        code.mov(Xbyak::Reg64{value_idx}, code.ABI_RETURN);
+    }
+    ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
+    code.ret();
+    PerfMapRegister(read_fallbacks[key], code.getCurr(),
+                    fmt::format("a64_read_fallback_{}", bitsize));
+}
 
-            for (const auto& [bitsize, callback] : read_callbacks) {
-                code.align();
-                read_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)] =
-                    code.getCurr<void (*)()>();
-                ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
-                if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
-                    code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-                }
-                callback.EmitCall(code);
-                if (value_idx != code.ABI_RETURN.getIdx()) {
-                    code.mov(Xbyak::Reg64{value_idx}, code.ABI_RETURN);
-                }
-                ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLocRegIdx(value_idx));
-                code.ret();
-                PerfMapRegister(read_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)],
-                                code.getCurr(), fmt::format("a64_read_fallback_{}", bitsize));
-            }
+void A64EmitX64::GenWriteFallback(size_t bitsize, int vaddr_idx, int value_idx) {
+    const auto key = std::make_tuple(bitsize, vaddr_idx, value_idx);
+    const bool software_tlb = UseSoftwareTLB();
 
-            for (const auto& [bitsize, callback] : write_callbacks) {
-                code.align();
-                write_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)] =
-                    code.getCurr<void (*)()>();
-                ABI_PushCallerSaveRegistersAndAdjustStack(code);
-                if (vaddr_idx == code.ABI_PARAM3.getIdx() &&
-                    value_idx == code.ABI_PARAM2.getIdx()) {
-                    code.xchg(code.ABI_PARAM2, code.ABI_PARAM3);
-                } else if (vaddr_idx == code.ABI_PARAM3.getIdx()) {
-                    code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-                    if (value_idx != code.ABI_PARAM3.getIdx()) {
-                        code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
-                    }
-                } else {
-                    if (value_idx != code.ABI_PARAM3.getIdx()) {
-                        code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
-                    }
-                    if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
-                        code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
-                    }
-                }
-                callback.EmitCall(code);
-                ABI_PopCallerSaveRegistersAndAdjustStack(code);
-                code.ret();
-                PerfMapRegister(write_fallbacks[std::make_tuple(bitsize, vaddr_idx, value_idx)],
-                                code.getCurr(), fmt::format("a64_write_fallback_{}", bitsize));
-            }
+    code.align();
+    write_fallbacks[key] = code.getCurr<FallbackFn>();
+
+    if (bitsize == 128) {
+        ABI_PushCallerSaveRegistersAndAdjustStack(code);
+        if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
+            code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
+        }
+        if (value_idx != 1) {
+            code.movaps(xmm1, Xbyak::Xmm{value_idx});
+        }
+        code.call(memory_write_128);
+        ABI_PopCallerSaveRegistersAndAdjustStack(code);
+        code.ret();
+        PerfMapRegister(write_fallbacks[key], code.getCurr(), "a64_write_fallback_128");
+        return;
+    }
+
+    const ArgCallback callback = [&] {
+        switch (bitsize) {
+        case 8:
+            return WriteCallback<&A64::UserCallbacks::MemoryWrite8>(conf.callbacks, software_tlb);
+        case 16:
+            return WriteCallback<&A64::UserCallbacks::MemoryWrite16>(conf.callbacks, software_tlb);
+        case 32:
+            return WriteCallback<&A64::UserCallbacks::MemoryWrite32>(conf.callbacks, software_tlb);
+        default:
+            ASSERT(bitsize == 64);
+            return WriteCallback<&A64::UserCallbacks::MemoryWrite64>(conf.callbacks, software_tlb);
+        }
+    }();
+
+    ABI_PushCallerSaveRegistersAndAdjustStack(code);
+    if (vaddr_idx == code.ABI_PARAM3.getIdx() && value_idx == code.ABI_PARAM2.getIdx()) {
+        code.xchg(code.ABI_PARAM2, code.ABI_PARAM3);
+    } else if (vaddr_idx == code.ABI_PARAM3.getIdx()) {
+        code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
+        if (value_idx != code.ABI_PARAM3.getIdx()) {
+            code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
+        }
+    } else {
+        if (value_idx != code.ABI_PARAM3.getIdx()) {
+            code.mov(code.ABI_PARAM3, Xbyak::Reg64{value_idx});
+        }
+        if (vaddr_idx != code.ABI_PARAM2.getIdx()) {
+            code.mov(code.ABI_PARAM2, Xbyak::Reg64{vaddr_idx});
         }
     }
+    callback.EmitCall(code, [&](RegList param) {
+        if (software_tlb) {
+            code.lea(param[2], ptr[r15 + offsetof(A64JitState, tlb)]);
+        }
+    });
+    ABI_PopCallerSaveRegistersAndAdjustStack(code);
+    code.ret();
+    PerfMapRegister(write_fallbacks[key], code.getCurr(),
+                    fmt::format("a64_write_fallback_{}", bitsize));
 }
 
 void A64EmitX64::GenTerminalHandlers() {
@@ -431,12 +522,19 @@ void A64EmitX64::EmitA64SetNZCV(A64EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
     const Xbyak::Reg32 to_store = ctx.reg_alloc.UseScratchGpr(args[0]).cvt32();
     code.mov(dword[r15 + offsetof(A64JitState, cpsr_nzcv)], to_store);
+    ctx.reg_alloc.SetGuestNZCV(inst->GetArg(0));
 }
 
 void A64EmitX64::EmitA64GetW(A64EmitContext& ctx, IR::Inst* inst) {
     const A64::Reg reg = inst->GetArg(0).GetA64RegRef();
     const Xbyak::Reg32 result = ctx.reg_alloc.ScratchGpr().cvt32();
 
+    if (const auto loop_reg = LoopRegister(reg)) {
+        code.mov(result, loop_reg->cvt32());
+        ctx.reg_alloc.DefineValue(inst, result);
+        return;
+    }
+
     code.mov(result,
              dword[r15 + offsetof(A64JitState, reg) + sizeof(u64) * static_cast<size_t>(reg)]);
     ctx.reg_alloc.DefineValue(inst, result);
@@ -446,6 +544,12 @@ void A64EmitX64::EmitA64GetX(A64EmitContext& ctx, IR::Inst* inst) {
     const A64::Reg reg = inst->GetArg(0).GetA64RegRef();
     const Xbyak::Reg64 result = ctx.reg_alloc.ScratchGpr();
 
+    if (const auto loop_reg = LoopRegister(reg)) {
+        code.mov(result, *loop_reg);
+        ctx.reg_alloc.DefineValue(inst, result);
+        return;
+    }
+
     code.mov(result,
              qword[r15 + offsetof(A64JitState, reg) + sizeof(u64) * static_cast<size_t>(reg)]);
     ctx.reg_alloc.DefineValue(inst, result);
@@ -507,6 +611,14 @@ void A64EmitX64::EmitA64GetFPSR(A64EmitContext& ctx, IR::Inst* inst) {
 void A64EmitX64::EmitA64SetW(A64EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
     const A64::Reg reg = inst->GetArg(0).GetA64RegRef();
+    if (const auto loop_reg = LoopRegister(reg)) {
+        if (args[1].IsImmediate()) {
+            code.mov(loop_reg->cvt32(), args[1].GetImmediateU32());
+        } else {
+            code.mov(loop_reg->cvt32(), ctx.reg_alloc.UseGpr(args[1]).cvt32());
+        }
+        return;
+    }
     const auto addr =
         qword[r15 + offsetof(A64JitState, reg) + sizeof(u64) * static_cast<size_t>(reg)];
     if (args[1].FitsInImmediateS32()) {
@@ -522,6 +634,16 @@ void A64EmitX64::EmitA64SetW(A64EmitContext& ctx, IR::Inst* inst) {
 void A64EmitX64::EmitA64SetX(A64EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
     const A64::Reg reg = inst->GetArg(0).GetA64RegRef();
+    if (const auto loop_reg = LoopRegister(reg)) {
+        if (args[1].IsImmediate()) {
+            code.mov(*loop_reg, args[1].GetImmediateU64());
+        } else if (args[1].IsInXmm()) {
+            code.movq(*loop_reg, ctx.reg_alloc.UseXmm(args[1]));
+        } else {
+            code.mov(*loop_reg, ctx.reg_alloc.UseGpr(args[1]));
+        }
+        return;
+    }
     const auto addr =
         qword[r15 + offsetof(A64JitState, reg) + sizeof(u64) * static_cast<size_t>(reg)];
     if (args[1].FitsInImmediateS32()) {
@@ -795,9 +917,87 @@ void EmitDetectMisaignedVAddr(BlockOfCode& code, A64EmitContext& ctx, size_t bit
     code.SwitchToNearCode();
 }
 
+/// Paired accesses are checked as a whole so that the host never reads past the end of a page.
+void EmitDetectPageCrossingVAddr(BlockOfCode& code, A64EmitContext& ctx, size_t bytes,
+                                 Xbyak::Label& abort, Xbyak::Reg64 vaddr, Xbyak::Reg64 tmp) {
+    if (ctx.conf.flat_memory_base) {
+        return;
+    }
+
+    code.mov(tmp.cvt32(), vaddr.cvt32());
+    code.and_(tmp.cvt32(), static_cast<u32>(page_size - 1));
+    code.cmp(tmp.cvt32(), static_cast<u32>(page_size - bytes));
+    code.ja(abort, code.T_NEAR);
+}
+
+size_t PageTableLevelBits(const A64::UserConfig& conf, size_t level) {
+    const size_t valid_page_index_bits = conf.page_table_address_space_bits - page_bits;
+    const size_t bits_per_level = valid_page_index_bits / conf.page_table_levels;
+    if (level == 0) {
+        return valid_page_index_bits - bits_per_level * (conf.page_table_levels - 1);
+    }
+    return bits_per_level;
+}
+
+void EmitMultiLevelPageTableWalk(BlockOfCode& code, A64EmitContext& ctx, Xbyak::Label& abort,
+                                 Xbyak::Reg64 vaddr, Xbyak::Reg64 page_table, Xbyak::Reg64 tmp) {
+    const size_t unused_top_bits = 64 - ctx.conf.page_table_address_space_bits;
+
+    if (unused_top_bits != 0 && !ctx.conf.silently_mirror_page_table) {
+        code.mov(tmp, vaddr);
+        code.shr(tmp, int(ctx.conf.page_table_address_space_bits));
+        code.jnz(abort, code.T_NEAR);
+    }
+
+    size_t shift = ctx.conf.page_table_address_space_bits;
+    for (size_t level = 0; level < ctx.conf.page_table_levels; level++) {
+        const size_t level_bits = PageTableLevelBits(ctx.conf, level);
+        shift -= level_bits;
+
+        code.mov(tmp, vaddr);
+        code.shr(tmp, int(shift));
+        if (level != 0 || unused_top_bits != 0) {
+            code.and_(tmp, u32((1 << level_bits) - 1));
+        }
+        code.mov(page_table, qword[page_table + tmp * sizeof(void*)]);
+        code.test(page_table, page_table);
+        code.jz(abort, code.T_NEAR);
+    }
+}
+
+bool HasVAddrLookup(const A64::UserConfig& conf) {
+    return conf.page_table || conf.flat_memory_base;
+}
+
+Xbyak::RegExp EmitFlatMemoryLookup(BlockOfCode& code, A64EmitContext& ctx, Xbyak::Reg64 vaddr,
+                                   std::optional<Xbyak::Reg64> arg_scratch) {
+    const u64 mask = ctx.conf.flat_memory_mask;
+    if (mask == 0xFFFF'FFFF'FFFF'FFFFull) {
+        return r13 + vaddr;
+    }
+
+    const Xbyak::Reg64 tmp = arg_scratch ? *arg_scratch : ctx.reg_alloc.ScratchGpr();
+    const size_t mask_bits = Common::BitCount(mask);
+    if (mask_bits == 32) {
+        code.mov(tmp.cvt32(), vaddr.cvt32());
+    } else if (mask_bits < 32) {
+        code.mov(tmp.cvt32(), vaddr.cvt32());
+        code.and_(tmp.cvt32(), static_cast<u32>(mask));
+    } else {
+        code.mov(tmp, vaddr);
+        code.shl(tmp, int(64 - mask_bits));
+        code.shr(tmp, int(64 - mask_bits));
+    }
+    return r13 + tmp;
+}
+
 Xbyak::RegExp EmitVAddrLookup(BlockOfCode& code, A64EmitContext& ctx, size_t bitsize,
                               Xbyak::Label& abort, Xbyak::Reg64 vaddr,
                               std::optional<Xbyak::Reg64> arg_scratch = {}) {
+    if (ctx.conf.flat_memory_base) {
+        return EmitFlatMemoryLookup(code, ctx, vaddr, arg_scratch);
+    }
+
     const size_t valid_page_index_bits = ctx.conf.page_table_address_space_bits - page_bits;
     const size_t unused_top_bits = 64 - ctx.conf.page_table_address_space_bits;
 
@@ -807,6 +1007,16 @@ Xbyak::RegExp EmitVAddrLookup(BlockOfCode& code, A64EmitContext& ctx, size_t bit
     EmitDetectMisaignedVAddr(code, ctx, bitsize, abort, vaddr, tmp);
 
     code.mov(page_table, reinterpret_cast<u64>(ctx.conf.page_table));
+    if (ctx.conf.page_table_levels > 1) {
+        EmitMultiLevelPageTableWalk(code, ctx, abort, vaddr, page_table, tmp);
+        if (ctx.conf.absolute_offset_page_table) {
+            return page_table + vaddr;
+        }
+        code.mov(tmp, vaddr);
+        code.and_(tmp, static_cast<u32>(page_size - 1));
+        return page_table + tmp;
+    }
+
     code.mov(tmp, vaddr);
     if (unused_top_bits == 0) {
         code.shr(tmp, int(page_bits));
@@ -837,6 +1047,10 @@ Xbyak::RegExp EmitVAddrLookup(BlockOfCode& code, A64EmitContext& ctx, size_t bit
 
 } // namespace
 
+bool A64EmitX64::UseSoftwareTLB() const {
+    return !conf.page_table && !conf.flat_memory_base && conf.enable_software_tlb;
+}
+
 void A64EmitX64::EmitDirectPageTableMemoryRead(A64EmitContext& ctx, IR::Inst* inst,
                                                size_t bitsize) {
     Xbyak::Label abort, end;
@@ -845,7 +1059,11 @@ void A64EmitX64::EmitDirectPageTableMemoryRead(A64EmitContext& ctx, IR::Inst* in
     const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
     const Xbyak::Reg64 value = ctx.reg_alloc.ScratchGpr();
 
-    const auto src_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr, value);
+    const auto src_ptr =
+        UseSoftwareTLB()
+            ? EmitSoftwareTLBLookup(code, ctx.reg_alloc, offsetof(A64JitState, tlb), bitsize, abort,
+                                    vaddr, value)
+            : EmitVAddrLookup(code, ctx, bitsize, abort, vaddr, value);
     switch (bitsize) {
     case 8:
         code.movzx(value.cvt32(), code.byte[src_ptr]);
@@ -864,7 +1082,7 @@ void A64EmitX64::EmitDirectPageTableMemoryRead(A64EmitContext& ctx, IR::Inst* in
 
     code.SwitchToFarCode();
     code.L(abort);
-    code.call(read_fallbacks[std::make_tuple(bitsize, vaddr.getIdx(), value.getIdx())]);
+    code.call(GetReadFallback(bitsize, vaddr.getIdx(), value.getIdx()));
     code.jmp(end, code.T_NEAR);
     code.SwitchToNearCode();
 
@@ -879,7 +1097,11 @@ void A64EmitX64::EmitDirectPageTableMemoryWrite(A64EmitContext& ctx, IR::Inst* i
     const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
     const Xbyak::Reg64 value = ctx.reg_alloc.UseGpr(args[1]);
 
-    const auto dest_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr);
+    const auto dest_ptr =
+        UseSoftwareTLB()
+            ? EmitSoftwareTLBLookup(code, ctx.reg_alloc, offsetof(A64JitState, tlb), bitsize, abort,
+                                    vaddr)
+            : EmitVAddrLookup(code, ctx, bitsize, abort, vaddr);
     switch (bitsize) {
     case 8:
         code.mov(code.byte[dest_ptr], value.cvt8());
@@ -898,13 +1120,211 @@ void A64EmitX64::EmitDirectPageTableMemoryWrite(A64EmitContext& ctx, IR::Inst* i
 
     code.SwitchToFarCode();
     code.L(abort);
-    code.call(write_fallbacks[std::make_tuple(bitsize, vaddr.getIdx(), value.getIdx())]);
+    code.call(GetWriteFallback(bitsize, vaddr.getIdx(), value.getIdx()));
+    code.jmp(end, code.T_NEAR);
+    code.SwitchToNearCode();
+}
+
+void A64EmitX64::EmitDirectPageTableMemoryReadPair(A64EmitContext& ctx, IR::Inst* inst,
+                                                   size_t bitsize) {
+    ASSERT(HasVAddrLookup(conf));
+
+    const size_t bytes = bitsize / 8;
+    Xbyak::Label abort, end;
+
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 tmp = ctx.reg_alloc.ScratchGpr();
+
+    if (bitsize == 32) {
+        const Xbyak::Reg64 value = ctx.reg_alloc.ScratchGpr();
+
+        EmitDetectPageCrossingVAddr(code, ctx, bytes * 2, abort, vaddr, tmp);
+        const auto src_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr, tmp);
+        code.mov(value, qword[src_ptr]);
+        code.L(end);
+
+        code.SwitchToFarCode();
+        code.L(abort);
+        code.call(GetReadFallback(bitsize, vaddr.getIdx(), value.getIdx()));
+        code.mov(value.cvt32(), value.cvt32());
+        code.lea(tmp, ptr[vaddr + bytes]);
+        code.call(GetReadFallback(bitsize, tmp.getIdx(), tmp.getIdx()));
+        code.shl(tmp, 32);
+        code.or_(value, tmp);
+        code.jmp(end, code.T_NEAR);
+        code.SwitchToNearCode();
+
+        ctx.reg_alloc.DefineValue(inst, value);
+        return;
+    }
+
+    const Xbyak::Xmm value = ctx.reg_alloc.ScratchXmm();
+    const Xbyak::Xmm xmm_tmp = code.HasSSE41() ? value : ctx.reg_alloc.ScratchXmm();
+
+    EmitDetectPageCrossingVAddr(code, ctx, bytes * 2, abort, vaddr, tmp);
+    const auto src_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr, tmp);
+    code.movups(value, xword[src_ptr]);
+    code.L(end);
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.call(GetReadFallback(bitsize, vaddr.getIdx(), tmp.getIdx()));
+    code.movq(value, tmp);
+    code.lea(tmp, ptr[vaddr + bytes]);
+    code.call(GetReadFallback(bitsize, tmp.getIdx(), tmp.getIdx()));
+    if (code.HasSSE41()) {
+        code.pinsrq(value, tmp, 1);
+    } else {
+        code.movq(xmm_tmp, tmp);
+        code.punpcklqdq(value, xmm_tmp);
+    }
+    code.jmp(end, code.T_NEAR);
+    code.SwitchToNearCode();
+
+    ctx.reg_alloc.DefineValue(inst, value);
+}
+
+void A64EmitX64::EmitDirectPageTableMemoryWritePair(A64EmitContext& ctx, IR::Inst* inst,
+                                                    size_t bitsize) {
+    ASSERT(HasVAddrLookup(conf));
+
+    const size_t bytes = bitsize / 8;
+    Xbyak::Label abort, end;
+
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 value1 = ctx.reg_alloc.UseGpr(args[1]);
+    const Xbyak::Reg64 value2 = ctx.reg_alloc.UseGpr(args[2]);
+    const Xbyak::Reg64 tmp = ctx.reg_alloc.ScratchGpr();
+
+    EmitDetectPageCrossingVAddr(code, ctx, bytes * 2, abort, vaddr, tmp);
+    const auto dest_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr, tmp);
+    if (bitsize == 32) {
+        code.mov(dword[dest_ptr], value1.cvt32());
+        code.mov(dword[dest_ptr + bytes], value2.cvt32());
+    } else {
+        code.mov(qword[dest_ptr], value1);
+        code.mov(qword[dest_ptr + bytes], value2);
+    }
+    code.L(end);
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.call(GetWriteFallback(bitsize, vaddr.getIdx(), value1.getIdx()));
+    code.lea(tmp, ptr[vaddr + bytes]);
+    code.call(GetWriteFallback(bitsize, tmp.getIdx(), value2.getIdx()));
+    code.jmp(end, code.T_NEAR);
+    code.SwitchToNearCode();
+}
+
+void A64EmitX64::EmitMemoryReadViaPage(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize) {
+    Xbyak::Label abort, end;
+
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    ASSERT(args[2].IsImmediate());
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 host = ctx.reg_alloc.UseGpr(args[1]);
+    const u16 offset = args[2].GetImmediateU16();
+    const Xbyak::Reg64 value = ctx.reg_alloc.ScratchGpr();
+
+    code.test(host, host);
+    code.jz(abort, code.T_NEAR);
+    switch (bitsize) {
+    case 8:
+        code.movzx(value.cvt32(), code.byte[host + offset]);
+        break;
+    case 16:
+        code.movzx(value.cvt32(), word[host + offset]);
+        break;
+    case 32:
+        code.mov(value.cvt32(), dword[host + offset]);
+        break;
+    case 64:
+        code.mov(value, qword[host + offset]);
+        break;
+    }
+    code.L(end);
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.call(GetReadFallback(bitsize, vaddr.getIdx(), value.getIdx()));
+    code.jmp(end, code.T_NEAR);
+    code.SwitchToNearCode();
+
+    ctx.reg_alloc.DefineValue(inst, value);
+}
+
+void A64EmitX64::EmitMemoryWriteViaPage(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize) {
+    Xbyak::Label abort, end;
+
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    ASSERT(args[2].IsImmediate());
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 host = ctx.reg_alloc.UseGpr(args[1]);
+    const u16 offset = args[2].GetImmediateU16();
+    const Xbyak::Reg64 value = ctx.reg_alloc.UseGpr(args[3]);
+
+    code.test(host, host);
+    code.jz(abort, code.T_NEAR);
+    switch (bitsize) {
+    case 8:
+        code.mov(code.byte[host + offset], value.cvt8());
+        break;
+    case 16:
+        code.mov(word[host + offset], value.cvt16());
+        break;
+    case 32:
+        code.mov(dword[host + offset], value.cvt32());
+        break;
+    case 64:
+        code.mov(qword[host + offset], value);
+        break;
+    }
+    code.L(end);
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.call(GetWriteFallback(bitsize, vaddr.getIdx(), value.getIdx()));
+    code.jmp(end, code.T_NEAR);
+    code.SwitchToNearCode();
+}
+
+void A64EmitX64::EmitA64LookupPage(A64EmitContext& ctx, IR::Inst* inst) {
+    ASSERT(conf.page_table);
+
+    Xbyak::Label abort, end;
+
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    ASSERT(args[1].IsImmediate());
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 result = ctx.reg_alloc.ScratchGpr();
+    const u16 size = args[1].GetImmediateU16();
+
+    // The whole range must lie within the page that vaddr is on.
+    if (size > 1) {
+        code.lea(result, ptr[vaddr + (size - 1)]);
+        code.xor_(result, vaddr);
+        code.shr(result, int(page_bits));
+        code.jnz(abort, code.T_NEAR);
+    }
+
+    // Result is the host address of vaddr, or null if the range must go through the callbacks.
+    const auto host_ptr = EmitVAddrLookup(code, ctx, 8, abort, vaddr, result);
+    code.lea(result, ptr[host_ptr]);
+    code.L(end);
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.xor_(result.cvt32(), result.cvt32());
     code.jmp(end, code.T_NEAR);
     code.SwitchToNearCode();
+
+    ctx.reg_alloc.DefineValue(inst, result);
 }
 
 void A64EmitX64::EmitA64ReadMemory8(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryRead(ctx, inst, 8);
         return;
     }
@@ -915,7 +1335,7 @@ void A64EmitX64::EmitA64ReadMemory8(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64ReadMemory16(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryRead(ctx, inst, 16);
         return;
     }
@@ -926,7 +1346,7 @@ void A64EmitX64::EmitA64ReadMemory16(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64ReadMemory32(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryRead(ctx, inst, 32);
         return;
     }
@@ -937,7 +1357,7 @@ void A64EmitX64::EmitA64ReadMemory32(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64ReadMemory64(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryRead(ctx, inst, 64);
         return;
     }
@@ -948,7 +1368,7 @@ void A64EmitX64::EmitA64ReadMemory64(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64ReadMemory128(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf)) {
         Xbyak::Label abort, end;
 
         auto args = ctx.reg_alloc.GetArgumentInfo(inst);
@@ -961,7 +1381,7 @@ void A64EmitX64::EmitA64ReadMemory128(A64EmitContext& ctx, IR::Inst* inst) {
 
         code.SwitchToFarCode();
         code.L(abort);
-        code.call(read_fallbacks[std::make_tuple(128, vaddr.getIdx(), value.getIdx())]);
+        code.call(GetReadFallback(128, vaddr.getIdx(), value.getIdx()));
         code.jmp(end, code.T_NEAR);
         code.SwitchToNearCode();
 
@@ -975,16 +1395,40 @@ void A64EmitX64::EmitA64ReadMemory128(A64EmitContext& ctx, IR::Inst* inst) {
     ctx.reg_alloc.DefineValue(inst, xmm1);
 }
 
-void A64EmitX64::EmitA64ExclusiveReadMemory8(A64EmitContext& ctx, IR::Inst* inst) {
-    ASSERT(conf.global_monitor != nullptr);
-    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
-    ctx.reg_alloc.HostCall(inst, {}, args[0]);
-    code.mov(code.byte[r15 + offsetof(A64JitState, exclusive_state)], u8(1));
-    code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&conf));
-    code.CallLambda([](A64::UserConfig& conf, u64 vaddr) -> u8 {
-        return conf.global_monitor->ReadAndMark<u8>(
-            conf.processor_id, vaddr, [&]() -> u8 { return conf.callbacks->MemoryRead8(vaddr); });
-    });
+void A64EmitX64::EmitA64ReadMemoryPair32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitDirectPageTableMemoryReadPair(ctx, inst, 32);
+}
+
+void A64EmitX64::EmitA64ReadMemoryPair64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitDirectPageTableMemoryReadPair(ctx, inst, 64);
+}
+
+void A64EmitX64::EmitA64ReadMemoryViaPage8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryReadViaPage(ctx, inst, 8);
+}
+
+void A64EmitX64::EmitA64ReadMemoryViaPage16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryReadViaPage(ctx, inst, 16);
+}
+
+void A64EmitX64::EmitA64ReadMemoryViaPage32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryReadViaPage(ctx, inst, 32);
+}
+
+void A64EmitX64::EmitA64ReadMemoryViaPage64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryReadViaPage(ctx, inst, 64);
+}
+
+void A64EmitX64::EmitA64ExclusiveReadMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    ASSERT(conf.global_monitor != nullptr);
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+    ctx.reg_alloc.HostCall(inst, {}, args[0]);
+    code.mov(code.byte[r15 + offsetof(A64JitState, exclusive_state)], u8(1));
+    code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&conf));
+    code.CallLambda([](A64::UserConfig& conf, u64 vaddr) -> u8 {
+        return conf.global_monitor->ReadAndMark<u8>(
+            conf.processor_id, vaddr, [&]() -> u8 { return conf.callbacks->MemoryRead8(vaddr); });
+    });
 }
 
 void A64EmitX64::EmitA64ExclusiveReadMemory16(A64EmitContext& ctx, IR::Inst* inst) {
@@ -1046,7 +1490,7 @@ void A64EmitX64::EmitA64ExclusiveReadMemory128(A64EmitContext& ctx, IR::Inst* in
 }
 
 void A64EmitX64::EmitA64WriteMemory8(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryWrite(ctx, inst, 8);
         return;
     }
@@ -1057,7 +1501,7 @@ void A64EmitX64::EmitA64WriteMemory8(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64WriteMemory16(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryWrite(ctx, inst, 16);
         return;
     }
@@ -1068,7 +1512,7 @@ void A64EmitX64::EmitA64WriteMemory16(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64WriteMemory32(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryWrite(ctx, inst, 32);
         return;
     }
@@ -1079,7 +1523,7 @@ void A64EmitX64::EmitA64WriteMemory32(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64WriteMemory64(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf) || UseSoftwareTLB()) {
         EmitDirectPageTableMemoryWrite(ctx, inst, 64);
         return;
     }
@@ -1090,7 +1534,7 @@ void A64EmitX64::EmitA64WriteMemory64(A64EmitContext& ctx, IR::Inst* inst) {
 }
 
 void A64EmitX64::EmitA64WriteMemory128(A64EmitContext& ctx, IR::Inst* inst) {
-    if (conf.page_table) {
+    if (HasVAddrLookup(conf)) {
         Xbyak::Label abort, end;
 
         auto args = ctx.reg_alloc.GetArgumentInfo(inst);
@@ -1103,7 +1547,7 @@ void A64EmitX64::EmitA64WriteMemory128(A64EmitContext& ctx, IR::Inst* inst) {
 
         code.SwitchToFarCode();
         code.L(abort);
-        code.call(write_fallbacks[std::make_tuple(128, vaddr.getIdx(), value.getIdx())]);
+        code.call(GetWriteFallback(128, vaddr.getIdx(), value.getIdx()));
         code.jmp(end, code.T_NEAR);
         code.SwitchToNearCode();
         return;
@@ -1117,6 +1561,30 @@ void A64EmitX64::EmitA64WriteMemory128(A64EmitContext& ctx, IR::Inst* inst) {
     code.CallFunction(memory_write_128);
 }
 
+void A64EmitX64::EmitA64WriteMemoryPair32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitDirectPageTableMemoryWritePair(ctx, inst, 32);
+}
+
+void A64EmitX64::EmitA64WriteMemoryPair64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitDirectPageTableMemoryWritePair(ctx, inst, 64);
+}
+
+void A64EmitX64::EmitA64WriteMemoryViaPage8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryWriteViaPage(ctx, inst, 8);
+}
+
+void A64EmitX64::EmitA64WriteMemoryViaPage16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryWriteViaPage(ctx, inst, 16);
+}
+
+void A64EmitX64::EmitA64WriteMemoryViaPage32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryWriteViaPage(ctx, inst, 32);
+}
+
+void A64EmitX64::EmitA64WriteMemoryViaPage64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitMemoryWriteViaPage(ctx, inst, 64);
+}
+
 void A64EmitX64::EmitExclusiveWrite(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize) {
     ASSERT(conf.global_monitor != nullptr);
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
@@ -1223,12 +1691,739 @@ void A64EmitX64::EmitA64ExclusiveWriteMemory128(A64EmitContext& ctx, IR::Inst* i
     EmitExclusiveWrite(ctx, inst, 128);
 }
 
+namespace {
+
+enum class AtomicOp {
+    Swap,
+    Add,
+    And,
+    Or,
+    Eor,
+    SignedMax,
+    SignedMin,
+    UnsignedMax,
+    UnsignedMin,
+};
+
+template <typename T>
+T ReadMemoryViaCallbacks(A64::UserCallbacks* cb, u64 vaddr) {
+    if constexpr (sizeof(T) == 1) {
+        return cb->MemoryRead8(vaddr);
+    } else if constexpr (sizeof(T) == 2) {
+        return cb->MemoryRead16(vaddr);
+    } else if constexpr (sizeof(T) == 4) {
+        return cb->MemoryRead32(vaddr);
+    } else {
+        return cb->MemoryRead64(vaddr);
+    }
+}
+
+template <typename T>
+void WriteMemoryViaCallbacks(A64::UserCallbacks* cb, u64 vaddr, T value) {
+    if constexpr (sizeof(T) == 1) {
+        cb->MemoryWrite8(vaddr, value);
+    } else if constexpr (sizeof(T) == 2) {
+        cb->MemoryWrite16(vaddr, value);
+    } else if constexpr (sizeof(T) == 4) {
+        cb->MemoryWrite32(vaddr, value);
+    } else {
+        cb->MemoryWrite64(vaddr, value);
+    }
+}
+
+template <typename T>
+T ApplyAtomicOp(AtomicOp op, T old_value, T value) {
+    using S = std::make_signed_t<T>;
+
+    switch (op) {
+    case AtomicOp::Swap:
+        return value;
+    case AtomicOp::Add:
+        return static_cast<T>(old_value + value);
+    case AtomicOp::And:
+        return static_cast<T>(old_value & value);
+    case AtomicOp::Or:
+        return static_cast<T>(old_value | value);
+    case AtomicOp::Eor:
+        return static_cast<T>(old_value ^ value);
+    case AtomicOp::SignedMax:
+        return static_cast<S>(old_value) > static_cast<S>(value) ? old_value : value;
+    case AtomicOp::SignedMin:
+        return static_cast<S>(old_value) < static_cast<S>(value) ? old_value : value;
+    case AtomicOp::UnsignedMax:
+        return old_value > value ? old_value : value;
+    case AtomicOp::UnsignedMin:
+        return old_value < value ? old_value : value;
+    }
+    UNREACHABLE();
+}
+
+// The fallbacks below are used when the address is not backed by the page table (or when there is
+// no page table). They are only atomic with respect to other JIT instances if the memory callbacks
+// themselves are.
+
+template <typename T>
+u64 AtomicMemoryOperationFallback(A64::UserConfig& conf, u64 vaddr, u64 value, u32 op) {
+    const T old_value = ReadMemoryViaCallbacks<T>(conf.callbacks, vaddr);
+    WriteMemoryViaCallbacks<T>(
+        conf.callbacks, vaddr,
+        ApplyAtomicOp<T>(static_cast<AtomicOp>(op), old_value, static_cast<T>(value)));
+    return old_value;
+}
+
+template <typename T>
+u64 CompareAndSwapFallback(A64::UserConfig& conf, u64 vaddr, u64 expected, u64 desired) {
+    const T old_value = ReadMemoryViaCallbacks<T>(conf.callbacks, vaddr);
+    if (old_value == static_cast<T>(expected)) {
+        WriteMemoryViaCallbacks<T>(conf.callbacks, vaddr, static_cast<T>(desired));
+    }
+    return old_value;
+}
+
+/// values[0] holds the expected value and values[1] the desired value.
+/// The value previously in memory is returned in values[0].
+void CompareAndSwap128Fallback(A64::UserConfig& conf, u64 vaddr, A64::Vector* values) {
+    const A64::Vector old_value = conf.callbacks->MemoryRead128(vaddr);
+    if (old_value == values[0]) {
+        conf.callbacks->MemoryWrite128(vaddr, values[1]);
+    }
+    values[0] = old_value;
+}
+
+Xbyak::Reg ToWidth(size_t bitsize, const Xbyak::Reg64& reg) {
+    switch (bitsize) {
+    case 8:
+        return reg.cvt8();
+    case 16:
+        return reg.cvt16();
+    case 32:
+        return reg.cvt32();
+    case 64:
+        return reg;
+    }
+    UNREACHABLE();
+}
+
+void EmitZeroExtendResult(BlockOfCode& code, size_t bitsize, const Xbyak::Reg64& reg) {
+    switch (bitsize) {
+    case 8:
+        code.movzx(reg.cvt32(), reg.cvt8());
+        break;
+    case 16:
+        code.movzx(reg.cvt32(), reg.cvt16());
+        break;
+    case 32:
+        code.mov(reg.cvt32(), reg.cvt32());
+        break;
+    }
+}
+
+template <typename Fallback>
+void EmitAtomicFallbackThunk(BlockOfCode& code, A64EmitContext& ctx, Xbyak::Label& abort,
+                             Xbyak::Label& end, Fallback fn, std::optional<AtomicOp> op) {
+    Xbyak::Label thunk;
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.call(thunk);
+    code.jmp(end, code.T_NEAR);
+
+    code.L(thunk);
+    ABI_PushCallerSaveRegistersAndAdjustStackExcept(code, HostLoc::RAX);
+    code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&ctx.conf));
+    if (op) {
+        code.mov(code.ABI_PARAM4.cvt32(), static_cast<u32>(*op));
+    }
+    code.CallFunction(fn);
+    ABI_PopCallerSaveRegistersAndAdjustStackExcept(code, HostLoc::RAX);
+    code.ret();
+    code.SwitchToNearCode();
+}
+
+template <typename T>
+void EmitAtomicMemoryOperation(BlockOfCode& code, A64EmitContext& ctx, IR::Inst* inst,
+                               AtomicOp op) {
+    constexpr size_t bitsize = sizeof(T) * 8;
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+
+    if (!HasVAddrLookup(ctx.conf)) {
+        ctx.reg_alloc.HostCall(inst, {}, args[0], args[1]);
+        code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&ctx.conf));
+        code.mov(code.ABI_PARAM4.cvt32(), static_cast<u32>(op));
+        code.CallFunction(&AtomicMemoryOperationFallback<T>);
+        return;
+    }
+
+    Xbyak::Label abort, end;
+
+    // vaddr and value are pinned to the argument registers of the fallback.
+    ctx.reg_alloc.Use(args[0], ABI_PARAM2);
+    ctx.reg_alloc.UseScratch(args[1], ABI_PARAM3);
+    const Xbyak::Reg64 result = ctx.reg_alloc.ScratchGpr(HostLoc::RAX);
+    const Xbyak::Reg64 tmp = ctx.reg_alloc.ScratchGpr();
+    const Xbyak::Reg64 vaddr = code.ABI_PARAM2;
+    const Xbyak::Reg64 value = code.ABI_PARAM3;
+
+    const auto dest_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr);
+    switch (op) {
+    case AtomicOp::Swap:
+        code.mov(result, value);
+        code.xchg(ptr[dest_ptr], ToWidth(bitsize, result));
+        break;
+    case AtomicOp::Add:
+        code.mov(result, value);
+        code.lock();
+        code.xadd(ptr[dest_ptr], ToWidth(bitsize, result));
+        break;
+    default: {
+        const bool is_signed = op == AtomicOp::SignedMax || op == AtomicOp::SignedMin;
+        const bool is_minmax =
+            is_signed || op == AtomicOp::UnsignedMax || op == AtomicOp::UnsignedMin;
+        const Xbyak::Reg cmp_tmp = ToWidth(bitsize == 64 ? 64 : 32, tmp);
+        const Xbyak::Reg cmp_value = ToWidth(bitsize == 64 ? 64 : 32, value);
+
+        switch (bitsize) {
+        case 8:
+            code.movzx(result.cvt32(), code.byte[dest_ptr]);
+            break;
+        case 16:
+            code.movzx(result.cvt32(), word[dest_ptr]);
+            break;
+        case 32:
+            code.mov(result.cvt32(), dword[dest_ptr]);
+            break;
+        case 64:
+            code.mov(result, qword[dest_ptr]);
+            break;
+        }
+
+        if (is_minmax && bitsize < 32) {
+            if (is_signed) {
+                code.movsx(value.cvt32(), ToWidth(bitsize, value));
+            } else {
+                code.movzx(value.cvt32(), ToWidth(bitsize, value));
+            }
+        }
+
+        Xbyak::Label loop;
+        code.L(loop);
+        if (is_minmax) {
+            if (bitsize < 32 && is_signed) {
+                code.movsx(tmp.cvt32(), ToWidth(bitsize, result));
+            } else if (bitsize < 32) {
+                code.movzx(tmp.cvt32(), ToWidth(bitsize, result));
+            } else {
+                code.mov(cmp_tmp, ToWidth(bitsize, result));
+            }
+            code.cmp(cmp_tmp, cmp_value);
+        } else {
+            code.mov(tmp, result);
+        }
+
+        switch (op) {
+        case AtomicOp::And:
+            code.and_(tmp, value);
+            break;
+        case AtomicOp::Or:
+            code.or_(tmp, value);
+            break;
+        case AtomicOp::Eor:
+            code.xor_(tmp, value);
+            break;
+        case AtomicOp::SignedMax:
+            code.cmovl(cmp_tmp, cmp_value);
+            break;
+        case AtomicOp::SignedMin:
+            code.cmovg(cmp_tmp, cmp_value);
+            break;
+        case AtomicOp::UnsignedMax:
+            code.cmovb(cmp_tmp, cmp_value);
+            break;
+        case AtomicOp::UnsignedMin:
+            code.cmova(cmp_tmp, cmp_value);
+            break;
+        default:
+            UNREACHABLE();
+        }
+
+        code.lock();
+        code.cmpxchg(ptr[dest_ptr], ToWidth(bitsize, tmp));
+        code.jnz(loop);
+        break;
+    }
+    }
+    EmitZeroExtendResult(code, bitsize, result);
+    code.L(end);
+
+    EmitAtomicFallbackThunk(code, ctx, abort, end, &AtomicMemoryOperationFallback<T>, op);
+
+    ctx.reg_alloc.DefineValue(inst, result);
+}
+
+template <typename T>
+void EmitAtomicCompareAndSwap(BlockOfCode& code, A64EmitContext& ctx, IR::Inst* inst) {
+    constexpr size_t bitsize = sizeof(T) * 8;
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+
+    if (!HasVAddrLookup(ctx.conf)) {
+        ctx.reg_alloc.HostCall(inst, {}, args[0], args[1], args[2]);
+        code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&ctx.conf));
+        code.CallFunction(&CompareAndSwapFallback<T>);
+        return;
+    }
+
+    Xbyak::Label abort, end;
+
+    // vaddr, expected and desired are pinned to the argument registers of the fallback.
+    ctx.reg_alloc.Use(args[0], ABI_PARAM2);
+    ctx.reg_alloc.Use(args[1], ABI_PARAM3);
+    ctx.reg_alloc.Use(args[2], ABI_PARAM4);
+    const Xbyak::Reg64 result = ctx.reg_alloc.ScratchGpr(HostLoc::RAX);
+    const Xbyak::Reg64 vaddr = code.ABI_PARAM2;
+    const Xbyak::Reg64 expected = code.ABI_PARAM3;
+    const Xbyak::Reg64 desired = code.ABI_PARAM4;
+
+    const auto dest_ptr = EmitVAddrLookup(code, ctx, bitsize, abort, vaddr);
+    code.mov(result, expected);
+    code.lock();
+    code.cmpxchg(ptr[dest_ptr], ToWidth(bitsize, desired));
+    EmitZeroExtendResult(code, bitsize, result);
+    code.L(end);
+
+    EmitAtomicFallbackThunk(code, ctx, abort, end, &CompareAndSwapFallback<T>, std::nullopt);
+
+    ctx.reg_alloc.DefineValue(inst, result);
+}
+
+void EmitAtomicCompareAndSwap128(BlockOfCode& code, A64EmitContext& ctx, IR::Inst* inst) {
+    auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+
+    if (!HasVAddrLookup(ctx.conf)) {
+        ctx.reg_alloc.Use(args[0], ABI_PARAM2);
+        ctx.reg_alloc.Use(args[1], HostLoc::XMM1);
+        ctx.reg_alloc.Use(args[2], HostLoc::XMM2);
+        ctx.reg_alloc.EndOfAllocScope();
+        ctx.reg_alloc.HostCall(nullptr);
+
+        code.sub(rsp, 32 + ABI_SHADOW_SPACE);
+        code.movaps(xword[rsp + ABI_SHADOW_SPACE], xmm1);
+        code.movaps(xword[rsp + ABI_SHADOW_SPACE + 16], xmm2);
+        code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&ctx.conf));
+        code.lea(code.ABI_PARAM3, ptr[rsp + ABI_SHADOW_SPACE]);
+        code.CallFunction(&CompareAndSwap128Fallback);
+        code.movaps(xmm1, xword[rsp + ABI_SHADOW_SPACE]);
+        code.add(rsp, 32 + ABI_SHADOW_SPACE);
+        ctx.reg_alloc.DefineValue(inst, xmm1);
+        return;
+    }
+
+    Xbyak::Label abort, end, thunk;
+
+    // cmpxchg16b compares against rdx:rax and stores rcx:rbx.
+    ctx.reg_alloc.ScratchGpr(HostLoc::RAX);
+    ctx.reg_alloc.ScratchGpr(HostLoc::RDX);
+    ctx.reg_alloc.ScratchGpr(HostLoc::RBX);
+    ctx.reg_alloc.ScratchGpr(HostLoc::RCX);
+    const Xbyak::Xmm expected = ctx.reg_alloc.UseXmm(args[1]);
+    const Xbyak::Xmm desired = ctx.reg_alloc.UseXmm(args[2]);
+    const Xbyak::Reg64 vaddr = ctx.reg_alloc.UseGpr(args[0]);
+    const Xbyak::Reg64 tmp = ctx.reg_alloc.ScratchGpr();
+    const Xbyak::Xmm result = ctx.reg_alloc.ScratchXmm();
+
+    code.movq(rax, expected);
+    code.movq(rbx, desired);
+    if (code.HasSSE41()) {
+        code.pextrq(rdx, expected, 1);
+        code.pextrq(rcx, desired, 1);
+    } else {
+        code.movhlps(result, expected);
+        code.movq(rdx, result);
+        code.movhlps(result, desired);
+        code.movq(rcx, result);
+    }
+
+    const auto dest_ptr = EmitVAddrLookup(code, ctx, 128, abort, vaddr);
+    code.lea(tmp, ptr[dest_ptr]);
+    code.test(tmp, 0b1111);
+    code.jnz(abort, code.T_NEAR);
+    code.lock();
+    code.cmpxchg16b(ptr[tmp]);
+    code.L(end);
+
+    code.movq(result, rax);
+    if (code.HasSSE41()) {
+        code.pinsrq(result, rdx, 1);
+    } else {
+        const Xbyak::Xmm xmm_tmp = ctx.reg_alloc.ScratchXmm();
+        code.movq(xmm_tmp, rdx);
+        code.punpcklqdq(result, xmm_tmp);
+    }
+
+    code.SwitchToFarCode();
+    code.L(abort);
+    code.call(thunk);
+    code.jmp(end, code.T_NEAR);
+
+    code.L(thunk);
+    code.sub(rsp, 32);
+    code.mov(qword[rsp + 0], rax);
+    code.mov(qword[rsp + 8], rdx);
+    code.mov(qword[rsp + 16], rbx);
+    code.mov(qword[rsp + 24], rcx);
+    code.mov(rbx, rsp);
+    ABI_PushCallerSaveRegistersAndAdjustStack(code);
+    code.mov(code.ABI_PARAM2, vaddr);
+    code.mov(code.ABI_PARAM3, rbx);
+    code.mov(code.ABI_PARAM1, reinterpret_cast<u64>(&ctx.conf));
+    code.CallFunction(&CompareAndSwap128Fallback);
+    ABI_PopCallerSaveRegistersAndAdjustStack(code);
+    code.mov(rax, qword[rbx + 0]);
+    code.mov(rdx, qword[rbx + 8]);
+    code.add(rsp, 32);
+    code.ret();
+    code.SwitchToNearCode();
+
+    ctx.reg_alloc.DefineValue(inst, result);
+}
+
+} // namespace
+
+void A64EmitX64::EmitA64AtomicSwapMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::Swap);
+}
+
+void A64EmitX64::EmitA64AtomicSwapMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::Swap);
+}
+
+void A64EmitX64::EmitA64AtomicSwapMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::Swap);
+}
+
+void A64EmitX64::EmitA64AtomicSwapMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::Swap);
+}
+
+void A64EmitX64::EmitA64AtomicAddMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::Add);
+}
+
+void A64EmitX64::EmitA64AtomicAddMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::Add);
+}
+
+void A64EmitX64::EmitA64AtomicAddMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::Add);
+}
+
+void A64EmitX64::EmitA64AtomicAddMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::Add);
+}
+
+void A64EmitX64::EmitA64AtomicAndMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::And);
+}
+
+void A64EmitX64::EmitA64AtomicAndMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::And);
+}
+
+void A64EmitX64::EmitA64AtomicAndMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::And);
+}
+
+void A64EmitX64::EmitA64AtomicAndMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::And);
+}
+
+void A64EmitX64::EmitA64AtomicOrMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::Or);
+}
+
+void A64EmitX64::EmitA64AtomicOrMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::Or);
+}
+
+void A64EmitX64::EmitA64AtomicOrMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::Or);
+}
+
+void A64EmitX64::EmitA64AtomicOrMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::Or);
+}
+
+void A64EmitX64::EmitA64AtomicEorMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::Eor);
+}
+
+void A64EmitX64::EmitA64AtomicEorMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::Eor);
+}
+
+void A64EmitX64::EmitA64AtomicEorMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::Eor);
+}
+
+void A64EmitX64::EmitA64AtomicEorMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::Eor);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMaxMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::SignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMaxMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::SignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMaxMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::SignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMaxMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::SignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMinMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::SignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMinMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::SignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMinMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::SignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicSignedMinMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::SignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMaxMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::UnsignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMaxMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::UnsignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMaxMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::UnsignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMaxMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::UnsignedMax);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMinMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u8>(code, ctx, inst, AtomicOp::UnsignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMinMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u16>(code, ctx, inst, AtomicOp::UnsignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMinMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u32>(code, ctx, inst, AtomicOp::UnsignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicUnsignedMinMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicMemoryOperation<u64>(code, ctx, inst, AtomicOp::UnsignedMin);
+}
+
+void A64EmitX64::EmitA64AtomicCompareAndSwapMemory8(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicCompareAndSwap<u8>(code, ctx, inst);
+}
+
+void A64EmitX64::EmitA64AtomicCompareAndSwapMemory16(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicCompareAndSwap<u16>(code, ctx, inst);
+}
+
+void A64EmitX64::EmitA64AtomicCompareAndSwapMemory32(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicCompareAndSwap<u32>(code, ctx, inst);
+}
+
+void A64EmitX64::EmitA64AtomicCompareAndSwapMemory64(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicCompareAndSwap<u64>(code, ctx, inst);
+}
+
+void A64EmitX64::EmitA64AtomicCompareAndSwapMemory128(A64EmitContext& ctx, IR::Inst* inst) {
+    EmitAtomicCompareAndSwap128(code, ctx, inst);
+}
+
 std::string A64EmitX64::LocationDescriptorToFriendlyName(
     const IR::LocationDescriptor& ir_descriptor) const {
     const A64::LocationDescriptor descriptor{ir_descriptor};
     return fmt::format("a64_{:016X}_fpcr{:08X}", descriptor.PC(), descriptor.FPCR().Value());
 }
 
+bool A64EmitX64::PreservesHostFlags(IR::Opcode opcode) const {
+    switch (opcode) {
+    case IR::Opcode::A64GetW:
+    case IR::Opcode::A64GetX:
+    case IR::Opcode::A64GetSP:
+    case IR::Opcode::A64SetW:
+    case IR::Opcode::A64SetX:
+    case IR::Opcode::A64SetSP:
+    case IR::Opcode::A64SetPC:
+    case IR::Opcode::A64SetNZCV:
+        return true;
+    default:
+        return EmitX64::PreservesHostFlags(opcode);
+    }
+}
+
+bool A64EmitX64::IsSelfLoop(const IR::Block& block) const {
+    if (!conf.enable_optimizations || !conf.HasOptimization(OptimizationFlag::SelfLoopBlocks) ||
+        A64::LocationDescriptor{block.Location()}.SingleStepping()) {
+        return false;
+    }
+
+    // Guest registers are only written back on exit from the loop, so we cannot allow anything
+    // that hands control to the user mid-block.
+    for (const auto& inst : block) {
+        switch (inst.GetOpcode()) {
+        case IR::Opcode::A64CallSupervisor:
+        case IR::Opcode::A64ExceptionRaised:
+        case IR::Opcode::A64DataCacheOperationRaised:
+            return false;
+        default:
+            break;
+        }
+    }
+
+    const auto is_self_link = [&block](const IR::Terminal& terminal) {
+        const auto link = boost::get<IR::Term::LinkBlock>(&terminal);
+        return link && link->next == block.Location();
+    };
+
+    const IR::Terminal terminal = block.GetTerminal();
+    if (is_self_link(terminal)) {
+        return true;
+    }
+    if (const auto term = boost::get<IR::Term::If>(&terminal)) {
+        return term->if_ != IR::Cond::AL && term->if_ != IR::Cond::NV &&
+               (is_self_link(term->then_) || is_self_link(term->else_));
+    }
+    if (const auto term = boost::get<IR::Term::CheckBit>(&terminal)) {
+        return is_self_link(term->then_) || is_self_link(term->else_);
+    }
+    return false;
+}
+
+std::vector<std::pair<A64::Reg, HostLoc>> A64EmitX64::ChooseLoopRegisters(
+    const IR::Block& block) const {
+    // Only callee-save registers are used so that the values survive host calls.
+    std::vector<HostLoc> host_locs{HostLoc::RBP, HostLoc::R12, HostLoc::R14};
+    if (!conf.flat_memory_base) {
+        host_locs.push_back(HostLoc::R13);
+    }
+
+    std::array<size_t, 31> access_count{};
+    for (const auto& inst : block) {
+        switch (inst.GetOpcode()) {
+        case IR::Opcode::A64GetW:
+        case IR::Opcode::A64GetX:
+        case IR::Opcode::A64SetW:
+        case IR::Opcode::A64SetX:
+            access_count[A64::RegNumber(inst.GetArg(0).GetA64RegRef())]++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    std::vector<size_t> regs;
+    for (size_t i = 0; i < access_count.size(); i++) {
+        if (access_count[i] != 0) {
+            regs.push_back(i);
+        }
+    }
+    std::stable_sort(regs.begin(), regs.end(),
+                     [&](size_t a, size_t b) { return access_count[a] > access_count[b]; });
+
+    std::vector<std::pair<A64::Reg, HostLoc>> result;
+    for (size_t i = 0; i < regs.size() && i < host_locs.size(); i++) {
+        result.emplace_back(static_cast<A64::Reg>(regs[i]), host_locs[i]);
+    }
+    return result;
+}
+
+std::optional<Xbyak::Reg64> A64EmitX64::LoopRegister(A64::Reg reg) const {
+    const auto iter =
+        std::find_if(loop_registers.begin(), loop_registers.end(),
+                     [reg](const auto& loop_register) { return loop_register.first == reg; });
+    if (iter == loop_registers.end()) {
+        return std::nullopt;
+    }
+    return HostLocToReg64(iter->second);
+}
+
+void A64EmitX64::EmitLoadLoopRegisters() {
+    for (const auto& [reg, host_loc] : loop_registers) {
+        code.mov(HostLocToReg64(host_loc),
+                 qword[r15 + offsetof(A64JitState, reg) + sizeof(u64) * static_cast<size_t>(reg)]);
+    }
+}
+
+void A64EmitX64::EmitStoreLoopRegisters() {
+    for (const auto& [reg, host_loc] : loop_registers) {
+        code.mov(qword[r15 + offsetof(A64JitState, reg) + sizeof(u64) * static_cast<size_t>(reg)],
+                 HostLocToReg64(host_loc));
+    }
+}
+
+void A64EmitX64::EmitSelfLoopTerminal(const IR::Terminal& terminal,
+                                      IR::LocationDescriptor initial_location,
+                                      const void* loop_head) {
+    const auto is_self_link = [&](const IR::Terminal& term) {
+        const auto link = boost::get<IR::Term::LinkBlock>(&term);
+        return link && link->next == initial_location;
+    };
+
+    // The back edge jumps straight to the loop body, skipping the reload of guest registers.
+    const auto emit_back_edge = [&] {
+        code.cmp(qword[r15 + offsetof(A64JitState, cycles_remaining)], 0);
+        code.jg(loop_head);
+        EmitStoreLoopRegisters();
+        code.mov(rax, A64::LocationDescriptor{initial_location}.PC());
+        code.mov(qword[r15 + offsetof(A64JitState, pc)], rax);
+        code.ForceReturnFromRunCode();
+    };
+    const auto emit_exit = [&](const IR::Terminal& term) {
+        EmitStoreLoopRegisters();
+        EmitTerminal(term, initial_location, false);
+    };
+    const auto emit_branches = [&](Xbyak::Label& taken, const IR::Terminal& then_,
+                                   const IR::Terminal& else_) {
+        if (is_self_link(else_)) {
+            emit_back_edge();
+            code.L(taken);
+            emit_exit(then_);
+        } else {
+            emit_exit(else_);
+            code.L(taken);
+            emit_back_edge();
+        }
+    };
+
+    if (is_self_link(terminal)) {
+        emit_back_edge();
+    } else if (const auto term = boost::get<IR::Term::If>(&terminal)) {
+        const bool nzcv_in_host_flags = std::exchange(terminal_nzcv_in_host_flags, false);
+        Xbyak::Label pass = EmitCond(term->if_, nzcv_in_host_flags);
+        emit_branches(pass, term->then_, term->else_);
+    } else if (const auto term = boost::get<IR::Term::CheckBit>(&terminal)) {
+        Xbyak::Label set;
+        code.cmp(code.byte[r15 + offsetof(A64JitState, check_bit)], u8(0));
+        code.jnz(set, code.T_NEAR);
+        emit_branches(set, term->then_, term->else_);
+    } else {
+        UNREACHABLE();
+    }
+}
+
 void A64EmitX64::EmitTerminalImpl(IR::Term::Interpret terminal, IR::LocationDescriptor, bool) {
     code.SwitchMxcsrOnExit();
     Devirtualize<&A64::UserCallbacks::InterpreterFallback>(conf.callbacks)
@@ -1310,7 +2505,8 @@ void A64EmitX64::EmitTerminalImpl(IR::Term::If terminal, IR::LocationDescriptor
         EmitTerminal(terminal.then_, initial_location, is_single_step);
         break;
     default:
-        Xbyak::Label pass = EmitCond(terminal.if_);
+        const bool nzcv_in_host_flags = std::exchange(terminal_nzcv_in_host_flags, false);
+        Xbyak::Label pass = EmitCond(terminal.if_, nzcv_in_host_flags);
         EmitTerminal(terminal.else_, initial_location, is_single_step);
         code.L(pass);
         EmitTerminal(terminal.then_, initial_location, is_single_step);
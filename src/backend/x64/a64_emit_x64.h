@@ -6,7 +6,10 @@
 #pragma once
 
 #include <map>
+#include <optional>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <dynarmic/A64/a64.h>
 #include <dynarmic/A64/config.h>
@@ -15,6 +18,7 @@
 #include "backend/x64/block_range_information.h"
 #include "backend/x64/emit_x64.h"
 #include "frontend/A64/location_descriptor.h"
+#include "frontend/A64/types.h"
 #include "frontend/ir/terminal.h"
 
 namespace Dynarmic::Backend::X64 {
@@ -56,6 +60,11 @@ protected:
     A64::Jit* jit_interface;
     BlockRangeInformation<u64> block_ranges;
 
+    /// General-purpose registers available to the register allocator in the current block.
+    std::vector<HostLoc> gpr_order;
+    /// Kept across blocks so that its storage is reused rather than reallocated for each block.
+    RegAlloc reg_alloc;
+
     struct FastDispatchEntry {
         u64 location_descriptor = 0xFFFF'FFFF'FFFF'FFFFull;
         const void* code_ptr = nullptr;
@@ -70,17 +79,27 @@ protected:
     void (*memory_write_128)();
     void GenMemory128Accessors();
 
-    std::map<std::tuple<size_t, int, int>, void (*)()> read_fallbacks;
-    std::map<std::tuple<size_t, int, int>, void (*)()> write_fallbacks;
-    void GenFastmemFallbacks();
+    // Fallbacks are keyed by (bitsize, vaddr_idx, value_idx), and are generated on first use.
+    using FallbackFn = void (*)();
+    std::map<std::tuple<size_t, int, int>, FallbackFn> read_fallbacks;
+    std::map<std::tuple<size_t, int, int>, FallbackFn> write_fallbacks;
+    FallbackFn GetReadFallback(size_t bitsize, int vaddr_idx, int value_idx);
+    FallbackFn GetWriteFallback(size_t bitsize, int vaddr_idx, int value_idx);
+    void GenReadFallback(size_t bitsize, int vaddr_idx, int value_idx);
+    void GenWriteFallback(size_t bitsize, int vaddr_idx, int value_idx);
 
     const void* terminal_handler_pop_rsb_hint;
     const void* terminal_handler_fast_dispatch_hint = nullptr;
     FastDispatchEntry& (*fast_dispatch_table_lookup)(u64) = nullptr;
     void GenTerminalHandlers();
 
+    bool UseSoftwareTLB() const;
     void EmitDirectPageTableMemoryRead(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
     void EmitDirectPageTableMemoryWrite(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
+    void EmitDirectPageTableMemoryReadPair(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
+    void EmitDirectPageTableMemoryWritePair(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
+    void EmitMemoryReadViaPage(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
+    void EmitMemoryWriteViaPage(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
     void EmitExclusiveWrite(A64EmitContext& ctx, IR::Inst* inst, size_t bitsize);
 
     // Microinstruction emitters
@@ -95,6 +114,18 @@ protected:
 
     // Helpers
     std::string LocationDescriptorToFriendlyName(const IR::LocationDescriptor&) const override;
+    bool PreservesHostFlags(IR::Opcode opcode) const override;
+    bool terminal_nzcv_in_host_flags = false;
+
+    // Self-looping blocks
+    bool IsSelfLoop(const IR::Block& block) const;
+    std::vector<std::pair<A64::Reg, HostLoc>> ChooseLoopRegisters(const IR::Block& block) const;
+    std::optional<Xbyak::Reg64> LoopRegister(A64::Reg reg) const;
+    void EmitLoadLoopRegisters();
+    void EmitStoreLoopRegisters();
+    void EmitSelfLoopTerminal(const IR::Terminal& terminal, IR::LocationDescriptor initial_location,
+                              const void* loop_head);
+    std::vector<std::pair<A64::Reg, HostLoc>> loop_registers;
 
     // Terminal instruction emitters
     void EmitTerminalImpl(IR::Term::Interpret terminal, IR::LocationDescriptor initial_location,
@@ -15,9 +15,13 @@
 #include "backend/x64/devirtualize.h"
 #include "backend/x64/jitstate_info.h"
 #include "common/assert.h"
+#include "common/cast_util.h"
 #include "common/llvm_disassemble.h"
+#include "common/fp/fpcr.h"
 #include "common/scope_exit.h"
+#include "frontend/A64/location_descriptor.h"
 #include "frontend/A64/translate/translate.h"
+#include "frontend/code_reader.h"
 #include "frontend/ir/basic_block.h"
 #include "ir_opt/passes.h"
 
@@ -35,8 +39,12 @@ static RunCodeCallbacks GenRunCodeCallbacks(A64::UserCallbacks* cb,
     };
 }
 
-static std::function<void(BlockOfCode&)> GenRCP(const A64::UserConfig&) {
-    return [](BlockOfCode&) {};
+static std::function<void(BlockOfCode&)> GenRCP(const A64::UserConfig& conf) {
+    return [conf](BlockOfCode& code) {
+        if (conf.flat_memory_base) {
+            code.mov(code.r13, Common::BitCast<u64>(conf.flat_memory_base));
+        }
+    };
 }
 
 struct Jit::Impl final {
@@ -48,6 +56,8 @@ public:
           emitter(block_of_code, conf, jit) {
         ASSERT(conf.page_table_address_space_bits >= 12 &&
                conf.page_table_address_space_bits <= 64);
+        ASSERT(conf.page_table_levels >= 1 && conf.page_table_levels <= 4);
+        ASSERT(((conf.flat_memory_mask + 1) & conf.flat_memory_mask) == 0);
     }
 
     ~Impl() = default;
@@ -120,6 +130,10 @@ public:
         jit_state.halt_requested = true;
     }
 
+    void FlushSoftwareTLB() {
+        jit_state.tlb.Flush();
+    }
+
     u64 GetSP() const {
         return jit_state.sp;
     }
@@ -248,20 +262,14 @@ private:
         }
 
         // JIT Compile
-        const auto get_code = [this](u64 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); };
+        const auto get_code = CodeReader<UserCallbacks, u64>{conf.callbacks};
+        A64::TranslationOptions options{conf.define_unpredictable_behaviour,
+                                        conf.wall_clock_cntpct};
+        options.max_instructions = conf.max_instructions_per_block;
         IR::Block ir_block =
-            A64::Translate(A64::LocationDescriptor{current_location}, get_code,
-                           {conf.define_unpredictable_behaviour, conf.wall_clock_cntpct});
+            A64::Translate(A64::LocationDescriptor{current_location}, get_code, options);
         Optimization::A64CallbackConfigPass(ir_block, conf);
-        if (conf.enable_optimizations) {
-            Optimization::A64GetSetElimination(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-            Optimization::ConstantPropagation(ir_block);
-            Optimization::DeadCodeElimination(ir_block);
-            Optimization::A64MergeInterpretBlocksPass(ir_block, conf.callbacks);
-        }
-        // printf("%s\n", IR::DumpBlock(ir_block).c_str());
-        Optimization::VerificationPass(ir_block);
+        Optimization::A64Optimize(ir_block, conf);
         return emitter.Emit(ir_block).entrypoint;
     }
 
@@ -333,6 +341,10 @@ void Jit::ExceptionalExit() {
     impl->ExceptionalExit();
 }
 
+void Jit::FlushSoftwareTLB() {
+    impl->FlushSoftwareTLB();
+}
+
 u64 Jit::GetSP() const {
     return impl->GetSP();
 }
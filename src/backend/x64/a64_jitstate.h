@@ -10,6 +10,7 @@
 #include <xbyak/xbyak.h>
 
 #include "backend/x64/nzcv_util.h"
+#include "backend/x64/software_tlb.h"
 #include "common/common_types.h"
 #include "frontend/A64/location_descriptor.h"
 
@@ -81,6 +82,9 @@ struct A64JitState {
     void SetFpcr(u32 value);
     void SetFpsr(u32 value);
 
+    // Software TLB (See: UserConfig::enable_software_tlb)
+    SoftwareTLB tlb;
+
     u64 GetUniqueHash() const noexcept {
         const u64 fpcr_u64 = static_cast<u64>(fpcr & A64::LocationDescriptor::fpcr_mask)
                              << A64::LocationDescriptor::fpcr_shift;
@@ -50,6 +50,7 @@ namespace {
 constexpr size_t TOTAL_CODE_SIZE = 128 * 1024 * 1024;
 constexpr size_t FAR_CODE_OFFSET = 100 * 1024 * 1024;
 constexpr size_t CONSTANT_POOL_SIZE = 2 * 1024 * 1024;
+constexpr size_t THUNK_CODE_SIZE = 1 * 1024 * 1024;
 
 class CustomXbyakAllocator : public Xbyak::Allocator {
 public:
@@ -91,6 +92,9 @@ BlockOfCode::BlockOfCode(RunCodeCallbacks cb, JitStateInfo jsi,
 
 void BlockOfCode::PreludeComplete() {
     prelude_complete = true;
+    thunk_code_ptr = getCurr();
+    thunk_code_end = getCurr() + THUNK_CODE_SIZE;
+    SetCodePtr(thunk_code_end);
     near_code_begin = getCurr();
     far_code_begin = getCurr() + FAR_CODE_OFFSET;
     ClearCache();
@@ -289,6 +293,19 @@ void BlockOfCode::SwitchToNearCode() {
     SetCodePtr(near_code_ptr);
 }
 
+CodePtr BlockOfCode::SwitchToThunkCode() {
+    ASSERT(prelude_complete);
+    const CodePtr return_code_ptr = getCurr();
+    SetCodePtr(thunk_code_ptr);
+    return return_code_ptr;
+}
+
+void BlockOfCode::SwitchFromThunkCode(CodePtr return_code_ptr) {
+    thunk_code_ptr = getCurr();
+    ASSERT_MSG(thunk_code_ptr <= thunk_code_end, "Thunk code has overflowed its region!");
+    SetCodePtr(return_code_ptr);
+}
+
 CodePtr BlockOfCode::GetCodeBegin() const {
     return near_code_begin;
 }
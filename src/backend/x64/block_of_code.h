@@ -100,6 +100,16 @@ public:
     void SwitchToFarCode();
     void SwitchToNearCode();
 
+    /// Thunk code sits in a region reserved after the preludes, which is preserved when the cache
+    /// is cleared. This allows thunks to be generated on first use, even while emitting a block.
+    /// @param gen Emits the thunk at the current code pointer.
+    template <typename GenFn>
+    void GenerateThunk(GenFn gen) {
+        const CodePtr return_code_ptr = SwitchToThunkCode();
+        gen();
+        SwitchFromThunkCode(return_code_ptr);
+    }
+
     CodePtr GetCodeBegin() const;
     size_t GetTotalCodeSize() const;
 
@@ -171,6 +181,11 @@ private:
     CodePtr near_code_begin;
     CodePtr far_code_begin;
 
+    CodePtr thunk_code_ptr;
+    CodePtr thunk_code_end;
+    CodePtr SwitchToThunkCode();
+    void SwitchFromThunkCode(CodePtr return_code_ptr);
+
     ConstantPool constant_pool;
 
     bool in_far_code = false;
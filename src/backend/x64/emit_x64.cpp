@@ -147,6 +147,7 @@ void EmitX64::EmitGetNZCVFromOp(EmitContext& ctx, IR::Inst* inst) {
     code.lahf();
     code.seto(code.al);
     ctx.reg_alloc.DefineValue(inst, nzcv);
+    ctx.reg_alloc.DefineHostFlags(inst);
 }
 
 void EmitX64::EmitNZCVFromPackedFlags(EmitContext& ctx, IR::Inst* inst) {
@@ -181,81 +182,98 @@ void EmitX64::EmitNZCVFromPackedFlags(EmitContext& ctx, IR::Inst* inst) {
     }
 }
 
-void EmitX64::EmitAddCycles(size_t cycles) {
+bool EmitX64::PreservesHostFlags(IR::Opcode opcode) const {
+    switch (opcode) {
+    case IR::Opcode::Void:
+    case IR::Opcode::Identity:
+    case IR::Opcode::ConditionalSelect32:
+    case IR::Opcode::ConditionalSelect64:
+    case IR::Opcode::ConditionalSelectNZCV:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void EmitX64::EmitAddCycles(size_t cycles, bool preserve_host_flags) {
     ASSERT(cycles < std::numeric_limits<u32>::max());
-    code.sub(qword[r15 + code.GetJitStateInfo().offsetof_cycles_remaining],
-             static_cast<u32>(cycles));
+    const auto cycles_remaining = qword[r15 + code.GetJitStateInfo().offsetof_cycles_remaining];
+    if (preserve_host_flags) {
+        ASSERT(cycles <= static_cast<size_t>(std::numeric_limits<s32>::max()));
+        code.mov(rcx, cycles_remaining);
+        code.lea(rcx, ptr[rcx - static_cast<s32>(cycles)]);
+        code.mov(cycles_remaining, rcx);
+        return;
+    }
+    code.sub(cycles_remaining, static_cast<u32>(cycles));
 }
 
-Xbyak::Label EmitX64::EmitCond(IR::Cond cond) {
+Xbyak::Label EmitX64::EmitCond(IR::Cond cond, bool nzcv_in_host_flags) {
     Xbyak::Label pass;
 
-    code.mov(eax, dword[r15 + code.GetJitStateInfo().offsetof_cpsr_nzcv]);
-
-    // sahf restores SF, ZF, CF
-    // add al, 0x7F restores OF
+    if (!nzcv_in_host_flags) {
+        code.mov(eax, dword[r15 + code.GetJitStateInfo().offsetof_cpsr_nzcv]);
+
+        // add al, 0x7F restores OF
+        // sahf restores SF, ZF, CF
+        switch (cond) {
+        case IR::Cond::VS:
+        case IR::Cond::VC:
+        case IR::Cond::GE:
+        case IR::Cond::LT:
+        case IR::Cond::GT:
+        case IR::Cond::LE:
+            code.add(al, 0x7F);
+            break;
+        default:
+            break;
+        }
+        code.sahf();
+    }
 
     switch (cond) {
     case IR::Cond::EQ: // z
-        code.sahf();
         code.jz(pass);
         break;
     case IR::Cond::NE: //! z
-        code.sahf();
         code.jnz(pass);
         break;
     case IR::Cond::CS: // c
-        code.sahf();
         code.jc(pass);
         break;
     case IR::Cond::CC: //! c
-        code.sahf();
         code.jnc(pass);
         break;
     case IR::Cond::MI: // n
-        code.sahf();
         code.js(pass);
         break;
     case IR::Cond::PL: //! n
-        code.sahf();
         code.jns(pass);
         break;
     case IR::Cond::VS: // v
-        code.add(al, 0x7F);
         code.jo(pass);
         break;
     case IR::Cond::VC: //! v
-        code.add(al, 0x7F);
         code.jno(pass);
         break;
     case IR::Cond::HI: // c & !z
-        code.sahf();
         code.cmc();
         code.ja(pass);
         break;
     case IR::Cond::LS: //! c | z
-        code.sahf();
         code.cmc();
         code.jna(pass);
         break;
     case IR::Cond::GE: // n == v
-        code.add(al, 0x7F);
-        code.sahf();
         code.jge(pass);
         break;
     case IR::Cond::LT: // n != v
-        code.add(al, 0x7F);
-        code.sahf();
         code.jl(pass);
         break;
     case IR::Cond::GT: // !z & (n == v)
-        code.add(al, 0x7F);
-        code.sahf();
         code.jg(pass);
         break;
     case IR::Cond::LE: // z | (n != v)
-        code.add(al, 0x7F);
-        code.sahf();
         code.jle(pass);
         break;
     default:
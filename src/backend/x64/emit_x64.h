@@ -86,8 +86,9 @@ protected:
 
     // Helpers
     virtual std::string LocationDescriptorToFriendlyName(const IR::LocationDescriptor&) const = 0;
-    void EmitAddCycles(size_t cycles);
-    Xbyak::Label EmitCond(IR::Cond cond);
+    void EmitAddCycles(size_t cycles, bool preserve_host_flags = false);
+    Xbyak::Label EmitCond(IR::Cond cond, bool nzcv_in_host_flags = false);
+    virtual bool PreservesHostFlags(IR::Opcode opcode) const;
     BlockDescriptor RegisterBlock(const IR::LocationDescriptor& location_descriptor,
                                   CodePtr entrypoint, size_t size);
     void PushRSBHelper(Xbyak::Reg64 loc_desc_reg, Xbyak::Reg64 index_reg,
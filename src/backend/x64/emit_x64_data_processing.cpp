@@ -32,6 +32,15 @@ void EmitX64::EmitPack2x32To1x64(EmitContext& ctx, IR::Inst* inst) {
 
 void EmitX64::EmitPack2x64To1x128(EmitContext& ctx, IR::Inst* inst) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
+
+    if (args[0].IsImmediate() && args[1].IsImmediate()) {
+        const Xbyak::Xmm result = ctx.reg_alloc.ScratchXmm();
+        code.movaps(result, code.MConst(xword, args[0].GetImmediateU64(),
+                                        args[1].GetImmediateU64()));
+        ctx.reg_alloc.DefineValue(inst, result);
+        return;
+    }
+
     const Xbyak::Reg64 lo = ctx.reg_alloc.UseGpr(args[0]);
     const Xbyak::Reg64 hi = ctx.reg_alloc.UseGpr(args[1]);
     const Xbyak::Xmm result = ctx.reg_alloc.ScratchXmm();
@@ -122,76 +131,70 @@ void EmitX64::EmitTestBit(EmitContext& ctx, IR::Inst* inst) {
 static void EmitConditionalSelect(BlockOfCode& code, EmitContext& ctx, IR::Inst* inst,
                                   int bitsize) {
     auto args = ctx.reg_alloc.GetArgumentInfo(inst);
-    const Xbyak::Reg32 nzcv = ctx.reg_alloc.ScratchGpr(HostLoc::RAX).cvt32();
+    const bool nzcv_in_host_flags = ctx.reg_alloc.IsGuestNZCVInHostFlags();
+    if (!nzcv_in_host_flags) {
+        ctx.reg_alloc.ScratchGpr(HostLoc::RAX);
+    }
     const Xbyak::Reg then_ = ctx.reg_alloc.UseGpr(args[1]).changeBit(bitsize);
     const Xbyak::Reg else_ = ctx.reg_alloc.UseScratchGpr(args[2]).changeBit(bitsize);
 
-    code.mov(nzcv, dword[r15 + code.GetJitStateInfo().offsetof_cpsr_nzcv]);
+    if (!nzcv_in_host_flags) {
+        code.mov(eax, dword[r15 + code.GetJitStateInfo().offsetof_cpsr_nzcv]);
+
+        // add al, 0x7F restores OF
+        // sahf restores SF, ZF, CF
+        code.add(al, 0x7F);
+        code.sahf();
 
-    // sahf restores SF, ZF, CF
-    // add al, 0x7F restores OF
+        // Subsequent conditional instructions can use the host flags directly.
+        ctx.reg_alloc.DefineGuestNZCVInHostFlags();
+    }
 
     switch (args[0].GetImmediateCond()) {
     case IR::Cond::EQ: // z
-        code.sahf();
         code.cmovz(else_, then_);
         break;
     case IR::Cond::NE: //! z
-        code.sahf();
         code.cmovnz(else_, then_);
         break;
     case IR::Cond::CS: // c
-        code.sahf();
         code.cmovc(else_, then_);
         break;
     case IR::Cond::CC: //! c
-        code.sahf();
         code.cmovnc(else_, then_);
         break;
     case IR::Cond::MI: // n
-        code.sahf();
         code.cmovs(else_, then_);
         break;
     case IR::Cond::PL: //! n
-        code.sahf();
         code.cmovns(else_, then_);
         break;
     case IR::Cond::VS: // v
-        code.add(nzcv.cvt8(), 0x7F);
         code.cmovo(else_, then_);
         break;
     case IR::Cond::VC: //! v
-        code.add(nzcv.cvt8(), 0x7F);
         code.cmovno(else_, then_);
         break;
     case IR::Cond::HI: // c & !z
-        code.sahf();
         code.cmc();
         code.cmova(else_, then_);
+        code.cmc();
         break;
     case IR::Cond::LS: //! c | z
-        code.sahf();
         code.cmc();
         code.cmovna(else_, then_);
+        code.cmc();
         break;
     case IR::Cond::GE: // n == v
-        code.add(nzcv.cvt8(), 0x7F);
-        code.sahf();
         code.cmovge(else_, then_);
         break;
     case IR::Cond::LT: // n != v
-        code.add(nzcv.cvt8(), 0x7F);
-        code.sahf();
         code.cmovl(else_, then_);
         break;
     case IR::Cond::GT: // !z & (n == v)
-        code.add(nzcv.cvt8(), 0x7F);
-        code.sahf();
         code.cmovg(else_, then_);
         break;
     case IR::Cond::LE: // z | (n != v)
-        code.add(nzcv.cvt8(), 0x7F);
-        code.sahf();
         code.cmovle(else_, then_);
         break;
     case IR::Cond::AL:
@@ -972,6 +975,7 @@ static void EmitAdd(BlockOfCode& code, EmitContext& ctx, IR::Inst* inst, int bit
         code.lahf();
         code.seto(code.al);
         ctx.reg_alloc.DefineValue(nzcv_inst, nzcv);
+        ctx.reg_alloc.DefineHostFlags(nzcv_inst);
         ctx.EraseInstruction(nzcv_inst);
     }
     if (carry_inst) {
@@ -1050,6 +1054,7 @@ static void EmitSub(BlockOfCode& code, EmitContext& ctx, IR::Inst* inst, int bit
         code.lahf();
         code.seto(code.al);
         ctx.reg_alloc.DefineValue(nzcv_inst, nzcv);
+        ctx.reg_alloc.DefineHostFlags(nzcv_inst);
         ctx.EraseInstruction(nzcv_inst);
     }
     if (carry_inst) {
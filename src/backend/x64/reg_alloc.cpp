@@ -4,6 +4,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
 #include <utility>
 
@@ -136,6 +137,10 @@ bool HostLocInfo::ContainsValue(const IR::Inst* inst) const {
     return std::find(values.begin(), values.end(), inst) != values.end();
 }
 
+const std::vector<IR::Inst*>& HostLocInfo::GetValues() const {
+    return values;
+}
+
 size_t HostLocInfo::GetMaxBitWidth() const {
     return max_bit_width;
 }
@@ -232,6 +237,70 @@ RegAlloc::RegAlloc(BlockOfCode& code, size_t num_spills,
     : gpr_order(gpr_order), xmm_order(xmm_order), hostloc_info(NonSpillHostLocCount + num_spills),
       code(code), spill_to_addr(std::move(spill_to_addr)) {}
 
+void RegAlloc::Reset(const std::vector<HostLoc>& new_gpr_order) {
+    AssertNoMoreUses();
+
+    gpr_order = new_gpr_order;
+    current_position = 0;
+    host_flags_inst = nullptr;
+    guest_nzcv_in_host_flags = false;
+}
+
+void RegAlloc::AnalyzeUses(const IR::Block& block) {
+    inst_positions.clear();
+    current_position = 0;
+
+    for (const auto& inst : block) {
+        inst_positions.emplace_back(&inst, inst_positions.size());
+    }
+    std::sort(inst_positions.begin(), inst_positions.end());
+
+    const auto for_each_use = [this, &block](auto fn) {
+        size_t position = 0;
+        for (const auto& inst : block) {
+            for (size_t i = 0; i < inst.NumArgs(); i++) {
+                const IR::Value arg = inst.GetArg(i);
+                if (arg.IsImmediate()) {
+                    continue;
+                }
+                if (const auto def_position = PositionOf(arg.GetInst())) {
+                    fn(*def_position, position);
+                }
+            }
+            position++;
+        }
+    };
+
+    // Counting the uses of the value at p into use_offsets[p + 2] makes the prefix sum leave the
+    // start of the uses of p in use_offsets[p + 1]. Filling in the uses of p through
+    // use_offsets[p + 1] then advances it to the start of the uses of p + 1, as required.
+    use_offsets.assign(inst_positions.size() + 2, 0);
+    for_each_use([this](size_t def_position, size_t) { use_offsets[def_position + 2]++; });
+    std::partial_sum(use_offsets.begin(), use_offsets.end(), use_offsets.begin());
+
+    use_positions.resize(use_offsets.back());
+    for_each_use([this](size_t def_position, size_t use_position) {
+        use_positions[use_offsets[def_position + 1]++] = use_position;
+    });
+    use_offsets.pop_back();
+}
+
+void RegAlloc::BeginInstruction(const IR::Inst* inst) {
+    if (const auto position = PositionOf(inst)) {
+        current_position = *position;
+    }
+}
+
+std::optional<size_t> RegAlloc::PositionOf(const IR::Inst* inst) const {
+    const auto iter =
+        std::lower_bound(inst_positions.begin(), inst_positions.end(), inst,
+                         [](const auto& entry, const IR::Inst* key) { return entry.first < key; });
+    if (iter == inst_positions.end() || iter->first != inst) {
+        return std::nullopt;
+    }
+    return iter->second;
+}
+
 RegAlloc::ArgumentInfo RegAlloc::GetArgumentInfo(IR::Inst* inst) {
     ArgumentInfo ret = {Argument{*this}, Argument{*this}, Argument{*this}, Argument{*this}};
     for (size_t i = 0; i < inst->NumArgs(); i++) {
@@ -451,6 +520,30 @@ void RegAlloc::HostCall(IR::Inst* result_def, std::optional<Argument::copyable_r
     }
 }
 
+void RegAlloc::DefineHostFlags(const IR::Inst* nzcv_inst) {
+    host_flags_inst = nzcv_inst;
+    guest_nzcv_in_host_flags = false;
+}
+
+void RegAlloc::SetGuestNZCV(const IR::Value& value) {
+    guest_nzcv_in_host_flags =
+        host_flags_inst && !value.IsImmediate() && value.GetInst() == host_flags_inst;
+}
+
+void RegAlloc::DefineGuestNZCVInHostFlags() {
+    host_flags_inst = nullptr;
+    guest_nzcv_in_host_flags = true;
+}
+
+bool RegAlloc::IsGuestNZCVInHostFlags() const {
+    return guest_nzcv_in_host_flags;
+}
+
+void RegAlloc::ClobberHostFlags() {
+    host_flags_inst = nullptr;
+    guest_nzcv_in_host_flags = false;
+}
+
 void RegAlloc::EndOfAllocScope() {
     for (auto& iter : hostloc_info) {
         iter.ReleaseAll();
@@ -463,23 +556,46 @@ void RegAlloc::AssertNoMoreUses() {
 }
 
 HostLoc RegAlloc::SelectARegister(const std::vector<HostLoc>& desired_locations) const {
-    std::vector<HostLoc> candidates = desired_locations;
-
-    // Find all locations that have not been allocated..
-    const auto allocated_locs =
-        std::partition(candidates.begin(), candidates.end(),
-                       [this](auto loc) { return !this->LocInfo(loc).IsLocked(); });
-    candidates.erase(allocated_locs, candidates.end());
-    ASSERT_MSG(!candidates.empty(), "All candidate registers have already been allocated");
-
-    // Selects the best location out of the available locations.
-    // TODO: Actually do LRU or something. Currently we just try to pick something without a value
-    // if possible.
+    // Selects the best location out of the locations that have not been allocated.
+    // An empty location is preferred. Failing that we evict the location whose values are needed
+    // furthest in the future, as these are the cheapest to spill.
+
+    std::optional<HostLoc> best_loc;
+    size_t best_distance = 0;
+    for (const HostLoc loc : desired_locations) {
+        const HostLocInfo& info = LocInfo(loc);
+        if (info.IsLocked()) {
+            continue;
+        }
+        if (info.IsEmpty()) {
+            return loc;
+        }
+        const size_t distance = NextUseDistance(loc);
+        if (!best_loc || distance > best_distance) {
+            best_loc = loc;
+            best_distance = distance;
+        }
+    }
 
-    std::partition(candidates.begin(), candidates.end(),
-                   [this](auto loc) { return this->LocInfo(loc).IsEmpty(); });
+    ASSERT_MSG(best_loc, "All candidate registers have already been allocated");
+    return *best_loc;
+}
 
-    return candidates.front();
+size_t RegAlloc::NextUseDistance(HostLoc loc) const {
+    size_t distance = std::numeric_limits<size_t>::max();
+    for (const IR::Inst* value : LocInfo(loc).GetValues()) {
+        const auto position = PositionOf(value);
+        if (!position) {
+            continue;
+        }
+        const auto begin = use_positions.begin() + use_offsets[*position];
+        const auto end = use_positions.begin() + use_offsets[*position + 1];
+        const auto next_use = std::lower_bound(begin, end, current_position);
+        if (next_use != end) {
+            distance = std::min(distance, *next_use - current_position);
+        }
+    }
+    return distance;
 }
 
 std::optional<HostLoc> RegAlloc::ValueLocation(const IR::Inst* value) const {
@@ -518,7 +634,7 @@ HostLoc RegAlloc::LoadImmediate(IR::Value imm, HostLoc host_loc) {
     if (HostLocIsGPR(host_loc)) {
         const Xbyak::Reg64 reg = HostLocToReg64(host_loc);
         const u64 imm_value = imm.GetImmediateAsU64();
-        if (imm_value == 0) {
+        if (imm_value == 0 && !host_flags_inst && !guest_nzcv_in_host_flags) {
             code.xor_(reg.cvt32(), reg.cvt32());
         } else {
             code.mov(reg, imm_value);
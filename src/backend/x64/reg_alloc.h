@@ -17,6 +17,7 @@
 #include "backend/x64/hostloc.h"
 #include "backend/x64/oparg.h"
 #include "common/common_types.h"
+#include "frontend/ir/basic_block.h"
 #include "frontend/ir/cond.h"
 #include "frontend/ir/microinstruction.h"
 #include "frontend/ir/value.h"
@@ -38,6 +39,7 @@ public:
     void ReleaseAll();
 
     bool ContainsValue(const IR::Inst* inst) const;
+    const std::vector<IR::Inst*>& GetValues() const;
     size_t GetMaxBitWidth() const;
 
     void AddValue(IR::Inst* inst);
@@ -100,6 +102,19 @@ public:
                       std::function<Xbyak::Address(HostLoc)> spill_to_addr,
                       std::vector<HostLoc> gpr_order, std::vector<HostLoc> xmm_order);
 
+    /// Prepares for allocating the registers of another block, allocating general-purpose
+    /// registers from gpr_order. The storage used for previous blocks is kept for reuse.
+    void Reset(const std::vector<HostLoc>& gpr_order);
+
+    /// Records where each value in block is used so that spill decisions can take into account
+    /// how soon a value is next needed.
+    /// Guest registers have no dedicated host registers: after GetSetElimination each is loaded
+    /// at most once and stored at most once per block, and in between it is an ordinary value
+    /// which this allocator keeps in a host register for as long as it is still needed.
+    void AnalyzeUses(const IR::Block& block);
+    /// Must be called before emitting each instruction of the block passed to AnalyzeUses.
+    void BeginInstruction(const IR::Inst* inst);
+
     ArgumentInfo GetArgumentInfo(IR::Inst* inst);
 
     Xbyak::Reg64 UseGpr(Argument& arg);
@@ -127,7 +142,15 @@ public:
                   std::optional<Argument::copyable_reference> arg2 = {},
                   std::optional<Argument::copyable_reference> arg3 = {});
 
-    // TODO: Values in host flags
+    /// Records that the host flags (SF, ZF, CF, OF) hold the NZCV value of nzcv_inst.
+    void DefineHostFlags(const IR::Inst* nzcv_inst);
+    /// Records that the guest NZCV flags in the jit state have been set to value.
+    void SetGuestNZCV(const IR::Value& value);
+    /// Records that the host flags hold the guest NZCV flags in the jit state.
+    void DefineGuestNZCVInHostFlags();
+    bool IsGuestNZCVInHostFlags() const;
+    /// Must be called before emitting code that may modify the host flags.
+    void ClobberHostFlags();
 
     void EndOfAllocScope();
 
@@ -140,6 +163,7 @@ private:
     std::vector<HostLoc> xmm_order;
 
     HostLoc SelectARegister(const std::vector<HostLoc>& desired_locations) const;
+    size_t NextUseDistance(HostLoc loc) const;
     std::optional<HostLoc> ValueLocation(const IR::Inst* value) const;
 
     HostLoc UseImpl(IR::Value use_value, const std::vector<HostLoc>& desired_locations);
@@ -161,6 +185,18 @@ private:
     HostLocInfo& LocInfo(HostLoc loc);
     const HostLocInfo& LocInfo(HostLoc loc) const;
 
+    /// Position of each instruction of the block, sorted by instruction address for lookup.
+    std::vector<std::pair<const IR::Inst*, size_t>> inst_positions;
+    /// The value defined at position p is used at use_positions[use_offsets[p]] up to (but not
+    /// including) use_positions[use_offsets[p + 1]], in increasing order.
+    std::vector<size_t> use_offsets;
+    std::vector<size_t> use_positions;
+    size_t current_position = 0;
+    std::optional<size_t> PositionOf(const IR::Inst* inst) const;
+
+    const IR::Inst* host_flags_inst = nullptr;
+    bool guest_nzcv_in_host_flags = false;
+
     BlockOfCode& code;
     std::function<Xbyak::Address(HostLoc)> spill_to_addr;
     void EmitMove(size_t bit_width, HostLoc to, HostLoc from);
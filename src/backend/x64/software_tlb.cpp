@@ -0,0 +1,46 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include "backend/x64/software_tlb.h"
+
+#include "backend/x64/block_of_code.h"
+#include "backend/x64/reg_alloc.h"
+
+namespace Dynarmic::Backend::X64 {
+
+using namespace Xbyak::util;
+
+Xbyak::RegExp EmitSoftwareTLBLookup(BlockOfCode& code, RegAlloc& reg_alloc, size_t tlb_offset,
+                                    size_t bitsize, Xbyak::Label& abort, Xbyak::Reg64 vaddr,
+                                    std::optional<Xbyak::Reg64> arg_scratch) {
+    static_assert(sizeof(SoftwareTLB::Entry) == 16);
+
+    const Xbyak::Reg64 index = arg_scratch ? *arg_scratch : reg_alloc.ScratchGpr();
+    const Xbyak::Reg64 tmp = reg_alloc.ScratchGpr();
+
+    const size_t entries_offset = tlb_offset + offsetof(SoftwareTLB, entries);
+    const size_t tag_offset = entries_offset + offsetof(SoftwareTLB::Entry, tag);
+    const size_t host_offset_offset = entries_offset + offsetof(SoftwareTLB::Entry, host_offset);
+
+    code.mov(tmp, vaddr);
+    code.shr(tmp, int(SoftwareTLB::PageBits));
+    code.mov(index.cvt32(), tmp.cvt32());
+    code.and_(index.cvt32(), u32(SoftwareTLB::Size - 1));
+    code.shl(index.cvt32(), 4);
+    code.cmp(tmp, qword[r15 + index + tag_offset]);
+    code.jne(abort, code.T_NEAR);
+
+    if (bitsize != 8) {
+        code.mov(tmp.cvt32(), vaddr.cvt32());
+        code.and_(tmp.cvt32(), u32(SoftwareTLB::PageMask));
+        code.cmp(tmp.cvt32(), u32(SoftwareTLB::PageSize - bitsize / 8));
+        code.ja(abort, code.T_NEAR);
+    }
+
+    code.mov(tmp, qword[r15 + index + host_offset_offset]);
+    return tmp + vaddr;
+}
+
+} // namespace Dynarmic::Backend::X64
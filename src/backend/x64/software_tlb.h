@@ -0,0 +1,127 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <optional>
+
+#include <mp/traits/function_info.h>
+#include <xbyak/xbyak.h>
+
+#include "backend/x64/callback.h"
+#include "common/common_types.h"
+
+namespace Dynarmic::Backend::X64 {
+
+class BlockOfCode;
+class RegAlloc;
+
+/// A direct-mapped cache of guest page to host page translations, stored in the jit state
+/// and probed inline by emitted code. Entries are filled by the TranslateAddress callback.
+struct SoftwareTLB {
+    static constexpr size_t PageBits = 12;
+    static constexpr u64 PageSize = u64(1) << PageBits;
+    static constexpr u64 PageMask = PageSize - 1;
+    static constexpr size_t Size = 256; // MUST be a power of 2.
+    static constexpr u64 InvalidTag = 0xFFFF'FFFF'FFFF'FFFFull;
+    /// Set in the tag of pages that do not translate. Emitted code never matches such a tag.
+    static constexpr u64 UntranslatedFlag = u64(1) << 63;
+
+    struct Entry {
+        u64 tag = InvalidTag;  // Guest page number, possibly with UntranslatedFlag.
+        u64 host_offset = 0;   // Host address minus guest address.
+    };
+    std::array<Entry, Size> entries{};
+
+    void Flush() {
+        entries.fill(Entry{});
+    }
+
+    /// Returns the host pointer for an access of access_size bytes at vaddr, calling translate
+    /// to fill the entry on a miss. Returns nullptr if the access straddles a page boundary
+    /// or if the page does not translate. Pages which do not translate are cached as such, so
+    /// that repeated accesses to them (e.g. MMIO) do not call translate every time.
+    template <typename TranslateFn>
+    u8* Lookup(u64 vaddr, size_t access_size, TranslateFn translate) {
+        if ((vaddr & PageMask) + access_size > PageSize) {
+            return nullptr;
+        }
+
+        const u64 page = vaddr >> PageBits;
+        Entry& entry = entries[page & (Size - 1)];
+        if (entry.tag == (page | UntranslatedFlag)) {
+            return nullptr;
+        }
+        if (entry.tag != page) {
+            void* const host_page = translate(page << PageBits);
+            if (!host_page) {
+                entry.tag = page | UntranslatedFlag;
+                return nullptr;
+            }
+            entry.tag = page;
+            entry.host_offset = reinterpret_cast<u64>(host_page) - (page << PageBits);
+        }
+        return reinterpret_cast<u8*>(entry.host_offset + vaddr);
+    }
+};
+
+namespace impl {
+
+template <auto callback>
+u64 SoftwareTLBReadThunk(mp::class_type<decltype(callback)>* this_, u64 vaddr, SoftwareTLB* tlb) {
+    using VAddr = mp::get_parameter<decltype(callback), 0>;
+    using T = mp::return_type<decltype(callback)>;
+
+    const auto translate = [this_](u64 page_vaddr) {
+        return this_->TranslateAddress(static_cast<VAddr>(page_vaddr));
+    };
+    if (const u8* host_ptr = tlb->Lookup(vaddr, sizeof(T), translate)) {
+        T value;
+        std::memcpy(&value, host_ptr, sizeof(T));
+        return value;
+    }
+    return (this_->*callback)(static_cast<VAddr>(vaddr));
+}
+
+template <auto callback>
+void SoftwareTLBWriteThunk(mp::class_type<decltype(callback)>* this_, u64 vaddr,
+                           mp::get_parameter<decltype(callback), 1> value, SoftwareTLB* tlb) {
+    using VAddr = mp::get_parameter<decltype(callback), 0>;
+
+    const auto translate = [this_](u64 page_vaddr) {
+        return this_->TranslateAddress(static_cast<VAddr>(page_vaddr));
+    };
+    if (u8* host_ptr = tlb->Lookup(vaddr, sizeof(value), translate)) {
+        std::memcpy(host_ptr, &value, sizeof(value));
+        return;
+    }
+    (this_->*callback)(static_cast<VAddr>(vaddr), value);
+}
+
+} // namespace impl
+
+/// Wraps a MemoryRead* callback such that the software TLB is consulted first.
+/// The returned callback expects a pointer to the SoftwareTLB as its second argument.
+template <auto callback>
+ArgCallback SoftwareTLBRead(mp::class_type<decltype(callback)>* this_) {
+    return ArgCallback{&impl::SoftwareTLBReadThunk<callback>, reinterpret_cast<u64>(this_)};
+}
+
+/// Wraps a MemoryWrite* callback such that the software TLB is consulted first.
+/// The returned callback expects a pointer to the SoftwareTLB as its third argument.
+template <auto callback>
+ArgCallback SoftwareTLBWrite(mp::class_type<decltype(callback)>* this_) {
+    return ArgCallback{&impl::SoftwareTLBWriteThunk<callback>, reinterpret_cast<u64>(this_)};
+}
+
+/// Emits an inline probe of the SoftwareTLB located at r15 + tlb_offset. Jumps to abort on a
+/// miss or if the access straddles a page boundary, otherwise returns the host address.
+Xbyak::RegExp EmitSoftwareTLBLookup(BlockOfCode& code, RegAlloc& reg_alloc, size_t tlb_offset,
+                                    size_t bitsize, Xbyak::Label& abort, Xbyak::Reg64 vaddr,
+                                    std::optional<Xbyak::Reg64> arg_scratch = {});
+
+} // namespace Dynarmic::Backend::X64
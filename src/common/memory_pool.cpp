@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "common/memory_pool.h"
@@ -11,12 +12,11 @@ namespace Dynarmic::Common {
 
 Pool::Pool(size_t object_size, size_t initial_pool_size)
     : object_size(object_size), slab_size(initial_pool_size) {
-    AllocateNewSlab();
+    slabs.emplace_back(static_cast<char*>(std::malloc(object_size * slab_size)));
+    Reset();
 }
 
 Pool::~Pool() {
-    std::free(current_slab);
-
     for (char* slab : slabs) {
         std::free(slab);
     }
@@ -24,8 +24,7 @@ Pool::~Pool() {
 
 void* Pool::Alloc() {
     if (remaining == 0) {
-        slabs.emplace_back(current_slab);
-        AllocateNewSlab();
+        AdvanceSlab();
     }
 
     void* ret = static_cast<void*>(current_ptr);
@@ -35,9 +34,24 @@ void* Pool::Alloc() {
     return ret;
 }
 
-void Pool::AllocateNewSlab() {
-    current_slab = static_cast<char*>(std::malloc(object_size * slab_size));
-    current_ptr = current_slab;
+void Pool::Reset(size_t max_retained_slabs) {
+    const size_t retained_slabs = std::max<size_t>(max_retained_slabs, 1);
+    while (slabs.size() > retained_slabs) {
+        std::free(slabs.back());
+        slabs.pop_back();
+    }
+
+    current_slab = 0;
+    current_ptr = slabs[0];
+    remaining = slab_size;
+}
+
+void Pool::AdvanceSlab() {
+    current_slab++;
+    if (current_slab == slabs.size()) {
+        slabs.emplace_back(static_cast<char*>(std::malloc(object_size * slab_size)));
+    }
+    current_ptr = slabs[current_slab];
     remaining = slab_size;
 }
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace Dynarmic::Common {
@@ -28,15 +29,25 @@ public:
     /// Returns a pointer to an `object_size`-bytes block of memory.
     void* Alloc();
 
+    /**
+     * Makes all memory previously returned by Alloc available for reuse.
+     * By default slabs are retained, so subsequent allocations do not touch the system allocator
+     * until more memory than before is required.
+     *
+     * @param max_retained_slabs Slabs beyond this count (and beyond the first) are returned to the
+     *                           system allocator, bounding the memory a pool keeps after an
+     *                           unusually large use.
+     */
+    void Reset(size_t max_retained_slabs = SIZE_MAX);
+
 private:
-    // Allocates a completely new memory slab.
-    // Used when an entirely new slab is needed
-    // due the current one running out of usable space.
-    void AllocateNewSlab();
+    // Moves on to the next memory slab, allocating a completely new one
+    // if no previously allocated slab is available for reuse.
+    void AdvanceSlab();
 
     size_t object_size;
     size_t slab_size;
-    char* current_slab;
+    size_t current_slab = 0;
     char* current_ptr;
     size_t remaining;
     std::vector<char*> slabs;
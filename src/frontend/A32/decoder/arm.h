@@ -8,12 +8,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
 
 #include "common/bit_util.h"
 #include "common/common_types.h"
+#include "frontend/decoder/decode_table.h"
 #include "frontend/decoder/decoder_detail.h"
 #include "frontend/decoder/matcher.h"
 
@@ -22,8 +24,17 @@ namespace Dynarmic::A32 {
 template <typename Visitor>
 using ArmMatcher = Decoder::Matcher<Visitor, u32>;
 
+template <typename Visitor>
+using ArmDecodeTable = std::array<std::vector<ArmMatcher<Visitor>>, 0x1000>;
+
+namespace detail {
+inline size_t ToFastLookupIndexArm(u32 instruction) {
+    return ((instruction >> 4) & 0x00F) | ((instruction >> 16) & 0xFF0);
+}
+} // namespace detail
+
 template <typename V>
-std::vector<ArmMatcher<V>> GetArmDecodeTable() {
+std::vector<ArmMatcher<V>> GetArmMatchers() {
     std::vector<ArmMatcher<V>> table = {
 
 #define INST(fn, name, bitstring)                                                                  \
@@ -45,6 +56,12 @@ std::vector<ArmMatcher<V>> GetArmDecodeTable() {
     return table;
 }
 
+template <typename V>
+ArmDecodeTable<V> GetArmDecodeTable() {
+    return Decoder::GetDecodeTable<ArmDecodeTable<V>>(GetArmMatchers<V>(),
+                                                      detail::ToFastLookupIndexArm);
+}
+
 template <typename V>
 std::optional<std::reference_wrapper<const ArmMatcher<V>>> DecodeArm(u32 instruction) {
     static const auto table = GetArmDecodeTable<V>();
@@ -53,9 +70,11 @@ std::optional<std::reference_wrapper<const ArmMatcher<V>>> DecodeArm(u32 instruc
         return matcher.Matches(instruction);
     };
 
-    auto iter = std::find_if(table.begin(), table.end(), matches_instruction);
-    return iter != table.end() ? std::optional<std::reference_wrapper<const ArmMatcher<V>>>(*iter)
-                               : std::nullopt;
+    const auto& subtable = table[detail::ToFastLookupIndexArm(instruction)];
+    auto iter = std::find_if(subtable.begin(), subtable.end(), matches_instruction);
+    return iter != subtable.end()
+               ? std::optional<std::reference_wrapper<const ArmMatcher<V>>>(*iter)
+               : std::nullopt;
 }
 
 } // namespace Dynarmic::A32
@@ -6,12 +6,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
 
 #include "common/bit_util.h"
 #include "common/common_types.h"
+#include "frontend/decoder/decode_table.h"
 #include "frontend/decoder/decoder_detail.h"
 #include "frontend/decoder/matcher.h"
 
@@ -20,8 +22,17 @@ namespace Dynarmic::A32 {
 template <typename Visitor>
 using ASIMDMatcher = Decoder::Matcher<Visitor, u32>;
 
+template <typename Visitor>
+using ASIMDDecodeTable = std::array<std::vector<ASIMDMatcher<Visitor>>, 0x1000>;
+
+namespace detail {
+inline size_t ToFastLookupIndexASIMD(u32 instruction) {
+    return ((instruction >> 4) & 0x0FF) | ((instruction >> 12) & 0xF00);
+}
+} // namespace detail
+
 template <typename V>
-std::vector<ASIMDMatcher<V>> GetASIMDDecodeTable() {
+std::vector<ASIMDMatcher<V>> GetASIMDMatchers() {
     std::vector<ASIMDMatcher<V>> table = {
 
 #define INST(fn, name, bitstring)                                                                  \
@@ -39,6 +50,12 @@ std::vector<ASIMDMatcher<V>> GetASIMDDecodeTable() {
     return table;
 }
 
+template <typename V>
+ASIMDDecodeTable<V> GetASIMDDecodeTable() {
+    return Decoder::GetDecodeTable<ASIMDDecodeTable<V>>(GetASIMDMatchers<V>(),
+                                                        detail::ToFastLookupIndexASIMD);
+}
+
 template <typename V>
 std::optional<std::reference_wrapper<const ASIMDMatcher<V>>> DecodeASIMD(u32 instruction) {
     static const auto table = GetASIMDDecodeTable<V>();
@@ -47,9 +64,11 @@ std::optional<std::reference_wrapper<const ASIMDMatcher<V>>> DecodeASIMD(u32 ins
         return matcher.Matches(instruction);
     };
 
-    auto iter = std::find_if(table.begin(), table.end(), matches_instruction);
-    return iter != table.end() ? std::optional<std::reference_wrapper<const ASIMDMatcher<V>>>(*iter)
-                               : std::nullopt;
+    const auto& subtable = table[detail::ToFastLookupIndexASIMD(instruction)];
+    auto iter = std::find_if(subtable.begin(), subtable.end(), matches_instruction);
+    return iter != subtable.end()
+               ? std::optional<std::reference_wrapper<const ASIMDMatcher<V>>>(*iter)
+               : std::nullopt;
 }
 
 } // namespace Dynarmic::A32
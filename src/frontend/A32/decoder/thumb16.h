@@ -6,11 +6,13 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
 
 #include "common/common_types.h"
+#include "frontend/decoder/decode_table.h"
 #include "frontend/decoder/decoder_detail.h"
 #include "frontend/decoder/matcher.h"
 
@@ -19,9 +21,18 @@ namespace Dynarmic::A32 {
 template <typename Visitor>
 using Thumb16Matcher = Decoder::Matcher<Visitor, u16>;
 
+template <typename Visitor>
+using Thumb16DecodeTable = std::array<std::vector<Thumb16Matcher<Visitor>>, 0x400>;
+
+namespace detail {
+inline size_t ToFastLookupIndexThumb16(u16 instruction) {
+    return (instruction >> 6) & 0x3FF;
+}
+} // namespace detail
+
 template <typename V>
-std::optional<std::reference_wrapper<const Thumb16Matcher<V>>> DecodeThumb16(u16 instruction) {
-    static const std::vector<Thumb16Matcher<V>> table = {
+std::vector<Thumb16Matcher<V>> GetThumb16Matchers() {
+    return {
 
 #define INST(fn, name, bitstring)                                                                  \
     Decoder::detail::detail<Thumb16Matcher<V>>::GetMatcher(fn, name, bitstring)
@@ -125,13 +136,25 @@ std::optional<std::reference_wrapper<const Thumb16Matcher<V>>> DecodeThumb16(u16
 #undef INST
 
     };
+}
+
+template <typename V>
+Thumb16DecodeTable<V> GetThumb16DecodeTable() {
+    return Decoder::GetDecodeTable<Thumb16DecodeTable<V>>(GetThumb16Matchers<V>(),
+                                                          detail::ToFastLookupIndexThumb16);
+}
+
+template <typename V>
+std::optional<std::reference_wrapper<const Thumb16Matcher<V>>> DecodeThumb16(u16 instruction) {
+    static const auto table = GetThumb16DecodeTable<V>();
 
     const auto matches_instruction = [instruction](const auto& matcher) {
         return matcher.Matches(instruction);
     };
 
-    auto iter = std::find_if(table.begin(), table.end(), matches_instruction);
-    return iter != table.end()
+    const auto& subtable = table[detail::ToFastLookupIndexThumb16(instruction)];
+    auto iter = std::find_if(subtable.begin(), subtable.end(), matches_instruction);
+    return iter != subtable.end()
                ? std::optional<std::reference_wrapper<const Thumb16Matcher<V>>>(*iter)
                : std::nullopt;
 }
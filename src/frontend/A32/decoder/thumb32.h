@@ -6,10 +6,12 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <optional>
 #include <vector>
 
 #include "common/common_types.h"
+#include "frontend/decoder/decode_table.h"
 #include "frontend/decoder/decoder_detail.h"
 #include "frontend/decoder/matcher.h"
 
@@ -18,9 +20,18 @@ namespace Dynarmic::A32 {
 template <typename Visitor>
 using Thumb32Matcher = Decoder::Matcher<Visitor, u32>;
 
+template <typename Visitor>
+using Thumb32DecodeTable = std::array<std::vector<Thumb32Matcher<Visitor>>, 0x1000>;
+
+namespace detail {
+inline size_t ToFastLookupIndexThumb32(u32 instruction) {
+    return ((instruction >> 13) & 0x007) | ((instruction >> 17) & 0xFF8);
+}
+} // namespace detail
+
 template <typename V>
-std::optional<std::reference_wrapper<const Thumb32Matcher<V>>> DecodeThumb32(u32 instruction) {
-    static const std::vector<Thumb32Matcher<V>> table = {
+std::vector<Thumb32Matcher<V>> GetThumb32Matchers() {
+    return {
 
 #define INST(fn, name, bitstring)                                                                  \
     Decoder::detail::detail<Thumb32Matcher<V>>::GetMatcher(fn, name, bitstring)
@@ -345,13 +356,25 @@ std::optional<std::reference_wrapper<const Thumb32Matcher<V>>> DecodeThumb32(u32
 #undef INST
 
     };
+}
+
+template <typename V>
+Thumb32DecodeTable<V> GetThumb32DecodeTable() {
+    return Decoder::GetDecodeTable<Thumb32DecodeTable<V>>(GetThumb32Matchers<V>(),
+                                                          detail::ToFastLookupIndexThumb32);
+}
+
+template <typename V>
+std::optional<std::reference_wrapper<const Thumb32Matcher<V>>> DecodeThumb32(u32 instruction) {
+    static const auto table = GetThumb32DecodeTable<V>();
 
     const auto matches_instruction = [instruction](const auto& matcher) {
         return matcher.Matches(instruction);
     };
 
-    auto iter = std::find_if(table.begin(), table.end(), matches_instruction);
-    return iter != table.end()
+    const auto& subtable = table[detail::ToFastLookupIndexThumb32(instruction)];
+    auto iter = std::find_if(subtable.begin(), subtable.end(), matches_instruction);
+    return iter != subtable.end()
                ? std::optional<std::reference_wrapper<const Thumb32Matcher<V>>>(*iter)
                : std::nullopt;
 }
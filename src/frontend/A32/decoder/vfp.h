@@ -6,11 +6,13 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
 
 #include "common/common_types.h"
+#include "frontend/decoder/decode_table.h"
 #include "frontend/decoder/decoder_detail.h"
 #include "frontend/decoder/matcher.h"
 
@@ -19,9 +21,18 @@ namespace Dynarmic::A32 {
 template <typename Visitor>
 using VFPMatcher = Decoder::Matcher<Visitor, u32>;
 
+template <typename Visitor>
+using VFPDecodeTable = std::array<std::vector<VFPMatcher<Visitor>>, 0x1000>;
+
+namespace detail {
+inline size_t ToFastLookupIndexVFP(u32 instruction) {
+    return ((instruction >> 4) & 0x00F) | ((instruction >> 16) & 0xFF0);
+}
+} // namespace detail
+
 template <typename V>
-std::optional<std::reference_wrapper<const VFPMatcher<V>>> DecodeVFP(u32 instruction) {
-    static const std::vector<VFPMatcher<V>> table = {
+std::vector<VFPMatcher<V>> GetVFPMatchers() {
+    return {
 
 #define INST(fn, name, bitstring)                                                                  \
     Decoder::detail::detail<VFPMatcher<V>>::GetMatcher(&V::fn, name, bitstring),
@@ -29,6 +40,17 @@ std::optional<std::reference_wrapper<const VFPMatcher<V>>> DecodeVFP(u32 instruc
 #undef INST
 
     };
+}
+
+template <typename V>
+VFPDecodeTable<V> GetVFPDecodeTable() {
+    return Decoder::GetDecodeTable<VFPDecodeTable<V>>(GetVFPMatchers<V>(),
+                                                      detail::ToFastLookupIndexVFP);
+}
+
+template <typename V>
+std::optional<std::reference_wrapper<const VFPMatcher<V>>> DecodeVFP(u32 instruction) {
+    static const auto table = GetVFPDecodeTable<V>();
 
     if ((instruction & 0xF0000000) == 0xF0000000)
         return std::nullopt; // Don't try matching any unconditional instructions.
@@ -37,9 +59,11 @@ std::optional<std::reference_wrapper<const VFPMatcher<V>>> DecodeVFP(u32 instruc
         return matcher.Matches(instruction);
     };
 
-    auto iter = std::find_if(table.begin(), table.end(), matches_instruction);
-    return iter != table.end() ? std::optional<std::reference_wrapper<const VFPMatcher<V>>>(*iter)
-                               : std::nullopt;
+    const auto& subtable = table[detail::ToFastLookupIndexVFP(instruction)];
+    auto iter = std::find_if(subtable.begin(), subtable.end(), matches_instruction);
+    return iter != subtable.end()
+               ? std::optional<std::reference_wrapper<const VFPMatcher<V>>>(*iter)
+               : std::nullopt;
 }
 
 } // namespace Dynarmic::A32
@@ -231,6 +231,10 @@ IR::U64 IREmitter::ReadMemory64(const IR::U32& vaddr) {
     return current_location.EFlag() ? ByteReverseDual(value) : value;
 }
 
+IR::U64 IREmitter::ReadMemoryPair32(const IR::U32& vaddr) {
+    return Inst<IR::U64>(Opcode::A32ReadMemoryPair32, vaddr);
+}
+
 void IREmitter::WriteMemory(size_t bitsize, const IR::U32& vaddr, const IR::UAny& value) {
     switch (bitsize) {
     case 8:
@@ -276,6 +280,11 @@ void IREmitter::WriteMemory64(const IR::U32& vaddr, const IR::U64& value) {
     }
 }
 
+void IREmitter::WriteMemoryPair32(const IR::U32& vaddr, const IR::U32& value1,
+                                  const IR::U32& value2) {
+    Inst(Opcode::A32WriteMemoryPair32, vaddr, value1, value2);
+}
+
 IR::U32 IREmitter::ExclusiveWriteMemory8(const IR::U32& vaddr, const IR::U8& value) {
     return Inst<IR::U32>(Opcode::A32ExclusiveWriteMemory8, vaddr, value);
 }
@@ -79,11 +79,14 @@ public:
     IR::U16 ReadMemory16(const IR::U32& vaddr);
     IR::U32 ReadMemory32(const IR::U32& vaddr);
     IR::U64 ReadMemory64(const IR::U32& vaddr);
+    // Paired accesses operate on two consecutive raw words without any endianness conversion.
+    IR::U64 ReadMemoryPair32(const IR::U32& vaddr);
     void WriteMemory(size_t bitsize, const IR::U32& vaddr, const IR::UAny& value);
     void WriteMemory8(const IR::U32& vaddr, const IR::U8& value);
     void WriteMemory16(const IR::U32& vaddr, const IR::U16& value);
     void WriteMemory32(const IR::U32& vaddr, const IR::U32& value);
     void WriteMemory64(const IR::U32& vaddr, const IR::U64& value);
+    void WriteMemoryPair32(const IR::U32& vaddr, const IR::U32& value1, const IR::U32& value2);
     IR::U32 ExclusiveWriteMemory8(const IR::U32& vaddr, const IR::U8& value);
     IR::U32 ExclusiveWriteMemory16(const IR::U32& vaddr, const IR::U16& value);
     IR::U32 ExclusiveWriteMemory32(const IR::U32& vaddr, const IR::U32& value);
@@ -783,9 +783,8 @@ bool ThumbTranslatorVisitor::thumb16_SETEND(bool E) {
 }
 
 // CPS{IE,ID} <a,i,f>
-// A CPS is treated as a NOP in User mode.
 bool ThumbTranslatorVisitor::thumb16_CPS(bool, bool, bool, bool) {
-    return true;
+    return InterpretThisInstruction();
 }
 
 // REV <Rd>, <Rm>
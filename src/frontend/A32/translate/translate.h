@@ -43,9 +43,17 @@ IR::Block Translate(LocationDescriptor descriptor, MemoryReadCodeFuncType memory
  * This function translates a single provided instruction into our intermediate representation.
  * @param block The block to append the IR for the instruction to.
  * @param descriptor The location of the instruction. Includes information like PC, Thumb state, &c.
- * @param instruction The instruction to translate.
+ * @param instruction The instruction to translate. A 32-bit Thumb instruction has its first
+ * halfword in the upper half.
  * @return The translated instruction translated to the intermediate representation.
  */
 bool TranslateSingleInstruction(IR::Block& block, LocationDescriptor descriptor, u32 instruction);
 
+/**
+ * Determines the size of a Thumb instruction from its first halfword.
+ * @param first_part The first halfword of the instruction.
+ * @return true if this is a 16-bit instruction, false if it is the first half of a 32-bit one.
+ */
+bool IsThumb16(u16 first_part);
+
 } // namespace Dynarmic::A32
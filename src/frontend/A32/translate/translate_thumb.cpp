@@ -22,12 +22,8 @@ namespace {
 
 enum class ThumbInstSize { Thumb16, Thumb32 };
 
-bool IsThumb16(u16 first_part) {
-    return (first_part & 0xF800) <= 0xE800;
-}
-
-std::tuple<u32, ThumbInstSize> ReadThumbInstruction(u32 arm_pc,
-                                                    MemoryReadCodeFuncType memory_read_code) {
+std::tuple<u32, ThumbInstSize> ReadThumbInstruction(
+    u32 arm_pc, const MemoryReadCodeFuncType& memory_read_code) {
     u32 first_part = memory_read_code(arm_pc & 0xFFFFFFFC);
     if ((arm_pc & 0x2) != 0) {
         first_part >>= 16;
@@ -54,6 +50,10 @@ std::tuple<u32, ThumbInstSize> ReadThumbInstruction(u32 arm_pc,
 
 } // namespace
 
+bool IsThumb16(u16 first_part) {
+    return (first_part & 0xF800) <= 0xE800;
+}
+
 IR::Block TranslateThumb(LocationDescriptor descriptor, MemoryReadCodeFuncType memory_read_code,
                          const TranslationOptions& options) {
     const bool single_step = descriptor.SingleStepping();
@@ -77,7 +77,8 @@ IR::Block TranslateThumb(LocationDescriptor descriptor, MemoryReadCodeFuncType m
             if (const auto decoder = DecodeThumb32<ThumbTranslatorVisitor>(thumb_instruction)) {
                 should_continue = decoder->get().call(visitor, thumb_instruction);
             } else {
-                should_continue = visitor.thumb32_UDF();
+                // Most 32-bit instructions are not translated yet.
+                should_continue = visitor.InterpretThisInstruction();
             }
         }
 
@@ -99,7 +100,8 @@ bool TranslateSingleThumbInstruction(IR::Block& block, LocationDescriptor descri
                                      u32 thumb_instruction) {
     ThumbTranslatorVisitor visitor{block, descriptor, {}};
 
-    const bool is_thumb_16 = IsThumb16(static_cast<u16>(thumb_instruction));
+    // A 32-bit instruction has its first halfword in the upper half, as in TranslateThumb.
+    const bool is_thumb_16 = IsThumb16(static_cast<u16>(thumb_instruction >> 16));
     bool should_continue = true;
     if (is_thumb_16) {
         if (const auto decoder =
@@ -112,7 +114,7 @@ bool TranslateSingleThumbInstruction(IR::Block& block, LocationDescriptor descri
         if (const auto decoder = DecodeThumb32<ThumbTranslatorVisitor>(thumb_instruction)) {
             should_continue = decoder->get().call(visitor, thumb_instruction);
         } else {
-            should_continue = visitor.thumb32_UDF();
+            should_continue = visitor.InterpretThisInstruction();
         }
     }
 
@@ -5,14 +5,14 @@
 
 #pragma once
 
-#include <algorithm>
+#include <array>
 #include <functional>
 #include <optional>
-#include <set>
-#include <string>
-#include <vector>
+#include <tuple>
+#include <utility>
+
+#include <mp/traits/function_info.h>
 
-#include "common/bit_util.h"
 #include "common/common_types.h"
 #include "frontend/decoder/decoder_detail.h"
 #include "frontend/decoder/matcher.h"
@@ -20,68 +20,242 @@
 namespace Dynarmic::A64 {
 
 template <typename Visitor>
-using Matcher = Decoder::Matcher<Visitor, u32>;
-
-template <typename Visitor>
-using DecodeTable = std::array<std::vector<Matcher<Visitor>>, 0x1000>;
+using Matcher = Decoder::Matcher<Visitor, u32,
+                                 typename Visitor::instruction_return_type (*)(Visitor&, u32)>;
 
+/*
+ * The decoder is generated entirely at compile time from a64.inc: matchers are sorted into
+ * priority order, bucketed by a subset of instruction bits, and each handler is a function which
+ * directly calls the visitor's member function with the instruction's fields extracted.
+ */
 namespace detail {
-inline size_t ToFastLookupIndex(u32 instruction) {
-    return ((instruction >> 10) & 0x00F) | ((instruction >> 18) & 0xFF0);
-}
-} // namespace detail
 
-template <typename Visitor>
-DecodeTable<Visitor> GetDecodeTable() {
-    std::vector<Matcher<Visitor>> list = {
-#define INST(fn, name, bitstring)                                                                  \
-    Decoder::detail::detail<Matcher<Visitor>>::GetMatcher(&Visitor::fn, name, bitstring),
+struct DummyVisitor {
+    using instruction_return_type = bool;
+};
+
+using MatcherDetail = Decoder::detail::detail<Decoder::Matcher<DummyVisitor, u32>>;
+
+struct InstructionInfo {
+    const char* name;
+    const char* bitstring;
+    size_t line; ///< Line of a64.inc, which identifies the instruction to its handler.
+};
+
+inline constexpr std::array instruction_info{
+#define INST(fn, name, bitstring) InstructionInfo{name, bitstring, __LINE__},
 #include "a64.inc"
 #undef INST
-    };
+};
+
+inline constexpr size_t instruction_count = instruction_info.size();
+
+constexpr size_t GetIndexOfLine(size_t line) {
+    size_t index = 0;
+    while (instruction_info[index].line != line) {
+        index++;
+    }
+    return index;
+}
+
+inline constexpr size_t ToFastLookupIndex(u32 instruction) {
+    return ((instruction >> 10) & 0x00F) | ((instruction >> 18) & 0xFF0);
+}
+
+constexpr bool StringEqual(const char* a, const char* b) {
+    for (; *a != '\0' && *a == *b; a++, b++) {
+    }
+    return *a == *b;
+}
+
+constexpr size_t BitCount(u32 value) {
+    size_t count = 0;
+    for (; value != 0; value &= value - 1) {
+        count++;
+    }
+    return count;
+}
+
+template <size_t... index>
+constexpr auto GetMasksAndExpects(std::index_sequence<index...>) {
+    return std::array{MatcherDetail::GetMaskAndExpect(instruction_info[index].bitstring)...};
+}
+
+inline constexpr auto masks_and_expects =
+    GetMasksAndExpects(std::make_index_sequence<instruction_count>{});
+
+constexpr u32 GetMask(size_t index) {
+    return std::get<0>(masks_and_expects[index]);
+}
 
-    std::stable_sort(list.begin(), list.end(), [](const auto& matcher1, const auto& matcher2) {
-        // If a matcher has more bits in its mask it is more specific, so it should come first.
-        return Common::BitCount(matcher1.GetMask()) > Common::BitCount(matcher2.GetMask());
-    });
+constexpr u32 GetExpected(size_t index) {
+    return std::get<1>(masks_and_expects[index]);
+}
 
-    // Exceptions to the above rule of thumb.
-    const std::set<std::string> comes_first{
+/// If a matcher has more bits in its mask it is more specific, so it should come first. A few
+/// exceptions to this rule of thumb come before all other matchers, but are still ordered by
+/// specificity among themselves. Lower priorities come first.
+constexpr size_t GetPriority(size_t index) {
+    constexpr std::array comes_first{
         "MOVI, MVNI, ORR, BIC (vector, immediate)",
         "FMOV (vector, immediate)",
         "Unallocated SIMD modified immediate",
     };
 
-    std::stable_partition(list.begin(), list.end(), [&](const auto& matcher) {
-        return comes_first.count(matcher.GetName()) > 0;
-    });
-
-    DecodeTable<Visitor> table{};
-    for (size_t i = 0; i < table.size(); ++i) {
-        for (auto matcher : list) {
-            const auto expect = detail::ToFastLookupIndex(matcher.GetExpected());
-            const auto mask = detail::ToFastLookupIndex(matcher.GetMask());
-            if ((i & mask) == expect) {
-                table[i].push_back(matcher);
+    const size_t specificity = 32 - BitCount(GetMask(index));
+    for (const char* name : comes_first) {
+        if (StringEqual(instruction_info[index].name, name)) {
+            return specificity;
+        }
+    }
+    return 33 + specificity;
+}
+
+inline constexpr size_t max_priority = 33 + 32;
+
+/// Indices into instruction_info in priority order. This is a stable sort by priority.
+constexpr std::array<u16, instruction_count> GetPriorityOrder() {
+    std::array<size_t, instruction_count> priorities{};
+    for (size_t i = 0; i < instruction_count; i++) {
+        priorities[i] = GetPriority(i);
+    }
+
+    std::array<u16, instruction_count> order{};
+    size_t position = 0;
+    for (size_t priority = 0; priority <= max_priority; priority++) {
+        for (size_t i = 0; i < instruction_count; i++) {
+            if (priorities[i] == priority) {
+                order[position++] = static_cast<u16>(i);
             }
         }
     }
+    return order;
+}
+
+inline constexpr auto priority_order = GetPriorityOrder();
+
+inline constexpr size_t bucket_count = 0x1000;
+
+/// Calls fn with the index of every bucket an instruction matching the mask and expected value
+/// may fall into.
+template <typename Fn>
+constexpr void ForEachBucket(u32 mask, u32 expected, Fn fn) {
+    const size_t bucket_mask = ToFastLookupIndex(mask);
+    const size_t bucket_expected = ToFastLookupIndex(expected);
+    const size_t free_bits = ~bucket_mask & (bucket_count - 1);
+
+    // Enumerates every subset of free_bits.
+    size_t subset = free_bits;
+    while (true) {
+        fn(bucket_expected | subset);
+        if (subset == 0) {
+            break;
+        }
+        subset = (subset - 1) & free_bits;
+    }
+}
+
+constexpr size_t CountTableEntries() {
+    size_t count = 0;
+    for (size_t i = 0; i < instruction_count; i++) {
+        ForEachBucket(GetMask(i), GetExpected(i), [&](size_t) { count++; });
+    }
+    return count;
+}
+
+inline constexpr size_t table_entry_count = CountTableEntries();
+static_assert(table_entry_count <= 0xFFFF, "Decode table offsets must fit in a u16");
+static_assert(instruction_count <= 0xFFFF, "Matcher positions must fit in a u16");
+
+/// Each bucket lists positions in the priority-ordered matcher array, in priority order.
+struct DecodeTable {
+    std::array<u16, bucket_count + 1> offsets;
+    std::array<u16, table_entry_count> entries;
+};
+
+constexpr DecodeTable GetDecodeTable() {
+    DecodeTable table{};
+
+    std::array<u16, bucket_count> sizes{};
+    for (size_t i = 0; i < instruction_count; i++) {
+        ForEachBucket(GetMask(i), GetExpected(i), [&](size_t bucket) { sizes[bucket]++; });
+    }
+
+    for (size_t bucket = 0; bucket < bucket_count; bucket++) {
+        table.offsets[bucket + 1] = static_cast<u16>(table.offsets[bucket] + sizes[bucket]);
+    }
+
+    std::array<u16, bucket_count> cursors{};
+    for (size_t position = 0; position < instruction_count; position++) {
+        const size_t i = priority_order[position];
+        ForEachBucket(GetMask(i), GetExpected(i), [&](size_t bucket) {
+            table.entries[table.offsets[bucket] + cursors[bucket]++] = static_cast<u16>(position);
+        });
+    }
+
     return table;
 }
 
+inline constexpr DecodeTable decode_table = GetDecodeTable();
+
+template <typename Visitor, auto fn, size_t line, typename CallRetT, typename... Args,
+          size_t... iota>
+CallRetT CallVisitor(Visitor& v, u32 instruction, CallRetT (Visitor::*)(Args...),
+                     std::index_sequence<iota...>) {
+    constexpr const char* bitstring = instruction_info[GetIndexOfLine(line)].bitstring;
+    constexpr auto arg_info = MatcherDetail::GetArgInfo<sizeof...(Args)>(bitstring);
+    constexpr auto arg_masks = std::get<0>(arg_info);
+    constexpr auto arg_shifts = std::get<1>(arg_info);
+
+    (void)instruction;
+    (void)arg_masks;
+    (void)arg_shifts;
+    return (v.*fn)(static_cast<Args>((instruction & arg_masks[iota]) >> arg_shifts[iota])...);
+}
+
+/// Extracts the fields of an instruction and calls the visitor's handler for it directly.
+template <typename Visitor, auto fn, size_t line>
+typename Visitor::instruction_return_type Handler(Visitor& v, u32 instruction) {
+    using Iota = std::make_index_sequence<mp::parameter_count_v<decltype(fn)>>;
+    return CallVisitor<Visitor, fn, line>(v, instruction, fn, Iota{});
+}
+
+/// Handlers in the same order as instruction_info.
 template <typename Visitor>
-std::optional<std::reference_wrapper<const Matcher<Visitor>>> Decode(u32 instruction) {
-    static const auto table = GetDecodeTable<Visitor>();
+inline constexpr std::array handlers{
+#define INST(fn, name, bitstring) &Handler<Visitor, &Visitor::fn, __LINE__>,
+#include "a64.inc"
+#undef INST
+};
 
-    const auto matches_instruction = [instruction](const auto& matcher) {
-        return matcher.Matches(instruction);
-    };
+template <typename Visitor, size_t... position>
+constexpr std::array<Matcher<Visitor>, sizeof...(position)> GetMatchers(
+    std::index_sequence<position...>) {
+    return {Matcher<Visitor>{instruction_info[priority_order[position]].name,
+                             GetMask(priority_order[position]),
+                             GetExpected(priority_order[position]),
+                             handlers<Visitor>[priority_order[position]]}...};
+}
 
-    const auto& subtable = table[detail::ToFastLookupIndex(instruction)];
-    auto iter = std::find_if(subtable.begin(), subtable.end(), matches_instruction);
-    return iter != subtable.end()
-               ? std::optional<std::reference_wrapper<const Matcher<Visitor>>>(*iter)
-               : std::nullopt;
+template <typename Visitor>
+inline constexpr auto matchers =
+    GetMatchers<Visitor>(std::make_index_sequence<instruction_count>{});
+
+} // namespace detail
+
+template <typename Visitor>
+std::optional<std::reference_wrapper<const Matcher<Visitor>>> Decode(u32 instruction) {
+    const auto& table = detail::decode_table;
+    const auto& matchers = detail::matchers<Visitor>;
+
+    const size_t bucket = detail::ToFastLookupIndex(instruction);
+    for (size_t i = table.offsets[bucket]; i < table.offsets[bucket + 1]; i++) {
+        const Matcher<Visitor>& matcher = matchers[table.entries[i]];
+        if (matcher.Matches(instruction)) {
+            return matcher;
+        }
+    }
+    return std::nullopt;
 }
 
 } // namespace Dynarmic::A64
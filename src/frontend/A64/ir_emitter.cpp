@@ -120,6 +120,34 @@ IR::U128 IREmitter::ReadMemory128(const IR::U64& vaddr) {
     return Inst<IR::U128>(Opcode::A64ReadMemory128, vaddr);
 }
 
+IR::U64 IREmitter::ReadMemoryPair32(const IR::U64& vaddr) {
+    return Inst<IR::U64>(Opcode::A64ReadMemoryPair32, vaddr);
+}
+
+IR::U128 IREmitter::ReadMemoryPair64(const IR::U64& vaddr) {
+    return Inst<IR::U128>(Opcode::A64ReadMemoryPair64, vaddr);
+}
+
+IR::U64 IREmitter::LookupPage(const IR::U64& vaddr, u16 size) {
+    return Inst<IR::U64>(Opcode::A64LookupPage, vaddr, Imm16(size));
+}
+
+IR::UAny IREmitter::ReadMemoryViaPage(size_t bitsize, const IR::U64& vaddr, const IR::U64& host,
+                                      u16 offset) {
+    switch (bitsize) {
+    case 8:
+        return Inst<IR::UAny>(Opcode::A64ReadMemoryViaPage8, vaddr, host, Imm16(offset));
+    case 16:
+        return Inst<IR::UAny>(Opcode::A64ReadMemoryViaPage16, vaddr, host, Imm16(offset));
+    case 32:
+        return Inst<IR::UAny>(Opcode::A64ReadMemoryViaPage32, vaddr, host, Imm16(offset));
+    case 64:
+        return Inst<IR::UAny>(Opcode::A64ReadMemoryViaPage64, vaddr, host, Imm16(offset));
+    default:
+        UNREACHABLE();
+    }
+}
+
 IR::U8 IREmitter::ExclusiveReadMemory8(const IR::U64& vaddr) {
     return Inst<IR::U8>(Opcode::A64ExclusiveReadMemory8, vaddr);
 }
@@ -160,6 +188,36 @@ void IREmitter::WriteMemory128(const IR::U64& vaddr, const IR::U128& value) {
     Inst(Opcode::A64WriteMemory128, vaddr, value);
 }
 
+void IREmitter::WriteMemoryPair32(const IR::U64& vaddr, const IR::U32& value1,
+                                  const IR::U32& value2) {
+    Inst(Opcode::A64WriteMemoryPair32, vaddr, value1, value2);
+}
+
+void IREmitter::WriteMemoryPair64(const IR::U64& vaddr, const IR::U64& value1,
+                                  const IR::U64& value2) {
+    Inst(Opcode::A64WriteMemoryPair64, vaddr, value1, value2);
+}
+
+void IREmitter::WriteMemoryViaPage(const IR::U64& vaddr, const IR::U64& host, u16 offset,
+                                   const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        Inst(Opcode::A64WriteMemoryViaPage8, vaddr, host, Imm16(offset), value);
+        break;
+    case IR::Type::U16:
+        Inst(Opcode::A64WriteMemoryViaPage16, vaddr, host, Imm16(offset), value);
+        break;
+    case IR::Type::U32:
+        Inst(Opcode::A64WriteMemoryViaPage32, vaddr, host, Imm16(offset), value);
+        break;
+    case IR::Type::U64:
+        Inst(Opcode::A64WriteMemoryViaPage64, vaddr, host, Imm16(offset), value);
+        break;
+    default:
+        UNREACHABLE();
+    }
+}
+
 IR::U32 IREmitter::ExclusiveWriteMemory8(const IR::U64& vaddr, const IR::U8& value) {
     return Inst<IR::U32>(Opcode::A64ExclusiveWriteMemory8, vaddr, value);
 }
@@ -180,6 +238,165 @@ IR::U32 IREmitter::ExclusiveWriteMemory128(const IR::U64& vaddr, const IR::U128&
     return Inst<IR::U32>(Opcode::A64ExclusiveWriteMemory128, vaddr, value);
 }
 
+IR::UAny IREmitter::AtomicSwapMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicSwapMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicSwapMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicSwapMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicSwapMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicAddMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicAddMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicAddMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicAddMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicAddMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicAndMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicAndMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicAndMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicAndMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicAndMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicOrMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicOrMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicOrMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicOrMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicOrMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicEorMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicEorMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicEorMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicEorMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicEorMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicSignedMaxMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMaxMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMaxMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMaxMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMaxMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicSignedMinMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMinMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMinMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMinMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicSignedMinMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicUnsignedMaxMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMaxMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMaxMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMaxMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMaxMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAny IREmitter::AtomicUnsignedMinMemory(const IR::U64& vaddr, const IR::UAny& value) {
+    switch (value.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMinMemory8, vaddr, value);
+    case IR::Type::U16:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMinMemory16, vaddr, value);
+    case IR::Type::U32:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMinMemory32, vaddr, value);
+    case IR::Type::U64:
+        return Inst<IR::UAny>(Opcode::A64AtomicUnsignedMinMemory64, vaddr, value);
+    default:
+        UNREACHABLE();
+    }
+}
+
+IR::UAnyU128 IREmitter::AtomicCompareAndSwapMemory(const IR::U64& vaddr,
+                                                   const IR::UAnyU128& expected,
+                                                   const IR::UAnyU128& desired) {
+    ASSERT(expected.GetType() == desired.GetType());
+    switch (expected.GetType()) {
+    case IR::Type::U8:
+        return Inst<IR::UAnyU128>(Opcode::A64AtomicCompareAndSwapMemory8, vaddr, expected, desired);
+    case IR::Type::U16:
+        return Inst<IR::UAnyU128>(Opcode::A64AtomicCompareAndSwapMemory16, vaddr, expected,
+                                  desired);
+    case IR::Type::U32:
+        return Inst<IR::UAnyU128>(Opcode::A64AtomicCompareAndSwapMemory32, vaddr, expected,
+                                  desired);
+    case IR::Type::U64:
+        return Inst<IR::UAnyU128>(Opcode::A64AtomicCompareAndSwapMemory64, vaddr, expected,
+                                  desired);
+    case IR::Type::U128:
+        return Inst<IR::UAnyU128>(Opcode::A64AtomicCompareAndSwapMemory128, vaddr, expected,
+                                  desired);
+    default:
+        UNREACHABLE();
+    }
+}
+
 IR::U32 IREmitter::GetW(Reg reg) {
     if (reg == Reg::ZR)
         return Imm32(0);
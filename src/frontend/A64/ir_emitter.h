@@ -60,6 +60,11 @@ public:
     IR::U32 ReadMemory32(const IR::U64& vaddr);
     IR::U64 ReadMemory64(const IR::U64& vaddr);
     IR::U128 ReadMemory128(const IR::U64& vaddr);
+    IR::U64 ReadMemoryPair32(const IR::U64& vaddr);
+    IR::U128 ReadMemoryPair64(const IR::U64& vaddr);
+    IR::U64 LookupPage(const IR::U64& vaddr, u16 size);
+    IR::UAny ReadMemoryViaPage(size_t bitsize, const IR::U64& vaddr, const IR::U64& host,
+                               u16 offset);
     IR::U8 ExclusiveReadMemory8(const IR::U64& vaddr);
     IR::U16 ExclusiveReadMemory16(const IR::U64& vaddr);
     IR::U32 ExclusiveReadMemory32(const IR::U64& vaddr);
@@ -70,11 +75,26 @@ public:
     void WriteMemory32(const IR::U64& vaddr, const IR::U32& value);
     void WriteMemory64(const IR::U64& vaddr, const IR::U64& value);
     void WriteMemory128(const IR::U64& vaddr, const IR::U128& value);
+    void WriteMemoryPair32(const IR::U64& vaddr, const IR::U32& value1, const IR::U32& value2);
+    void WriteMemoryPair64(const IR::U64& vaddr, const IR::U64& value1, const IR::U64& value2);
+    void WriteMemoryViaPage(const IR::U64& vaddr, const IR::U64& host, u16 offset,
+                            const IR::UAny& value);
     IR::U32 ExclusiveWriteMemory8(const IR::U64& vaddr, const IR::U8& value);
     IR::U32 ExclusiveWriteMemory16(const IR::U64& vaddr, const IR::U16& value);
     IR::U32 ExclusiveWriteMemory32(const IR::U64& vaddr, const IR::U32& value);
     IR::U32 ExclusiveWriteMemory64(const IR::U64& vaddr, const IR::U64& value);
     IR::U32 ExclusiveWriteMemory128(const IR::U64& vaddr, const IR::U128& value);
+    IR::UAny AtomicSwapMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicAddMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicAndMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicOrMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicEorMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicSignedMaxMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicSignedMinMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicUnsignedMaxMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAny AtomicUnsignedMinMemory(const IR::U64& vaddr, const IR::UAny& value);
+    IR::UAnyU128 AtomicCompareAndSwapMemory(const IR::U64& vaddr, const IR::UAnyU128& expected,
+                                            const IR::UAnyU128& desired);
 
     IR::U32 GetW(Reg source_reg);
     IR::U64 GetX(Reg source_reg);
@@ -0,0 +1,169 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include "frontend/A64/translate/impl/impl.h"
+
+namespace Dynarmic::A64 {
+
+enum class AtomicMemOp {
+    ADD,
+    BIC,
+    EOR,
+    ORR,
+    SMAX,
+    SMIN,
+    UMAX,
+    UMIN,
+    SWP,
+};
+
+static IR::U64 AtomicAddress(TranslatorVisitor& v, Reg Rn) {
+    if (Rn == Reg::SP) {
+        // TODO: Check SP Alignment
+        return v.SP(64);
+    }
+    return v.X(64, Rn);
+}
+
+static bool AtomicMemoryOperation(TranslatorVisitor& v, Imm<2> size, AtomicMemOp op, Reg Rs,
+                                  Reg Rn, Reg Rt) {
+    const size_t datasize = 8 << size.ZeroExtend<size_t>();
+    const size_t regsize = datasize == 64 ? 64 : 32;
+
+    const IR::U64 address = AtomicAddress(v, Rn);
+
+    IR::UAny value = v.X(datasize, Rs);
+    if (op == AtomicMemOp::BIC) {
+        const IR::U32U64 inverted = v.ir.Not(v.X(regsize, Rs));
+        switch (datasize) {
+        case 8:
+            value = v.ir.LeastSignificantByte(inverted);
+            break;
+        case 16:
+            value = v.ir.LeastSignificantHalf(inverted);
+            break;
+        default:
+            value = inverted;
+            break;
+        }
+    }
+
+    const IR::UAny data = [&]() -> IR::UAny {
+        switch (op) {
+        case AtomicMemOp::ADD:
+            return v.ir.AtomicAddMemory(address, value);
+        case AtomicMemOp::BIC:
+            return v.ir.AtomicAndMemory(address, value);
+        case AtomicMemOp::EOR:
+            return v.ir.AtomicEorMemory(address, value);
+        case AtomicMemOp::ORR:
+            return v.ir.AtomicOrMemory(address, value);
+        case AtomicMemOp::SMAX:
+            return v.ir.AtomicSignedMaxMemory(address, value);
+        case AtomicMemOp::SMIN:
+            return v.ir.AtomicSignedMinMemory(address, value);
+        case AtomicMemOp::UMAX:
+            return v.ir.AtomicUnsignedMaxMemory(address, value);
+        case AtomicMemOp::UMIN:
+            return v.ir.AtomicUnsignedMinMemory(address, value);
+        case AtomicMemOp::SWP:
+            return v.ir.AtomicSwapMemory(address, value);
+        }
+        UNREACHABLE();
+    }();
+
+    v.X(regsize, Rt, v.ZeroExtend(data, regsize));
+    return true;
+}
+
+bool TranslatorVisitor::LDADD(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::ADD, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDCLR(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::BIC, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDEOR(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::EOR, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDSET(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::ORR, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDSMAX(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::SMAX, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDSMIN(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::SMIN, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDUMAX(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::UMAX, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::LDUMIN(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::UMIN, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::SWP(Imm<2> size, bool, bool, Reg Rs, Reg Rn, Reg Rt) {
+    return AtomicMemoryOperation(*this, size, AtomicMemOp::SWP, Rs, Rn, Rt);
+}
+
+static bool CompareAndSwap(TranslatorVisitor& v, size_t size, Reg Rs, Reg Rn, Reg Rt) {
+    const size_t datasize = 8 << size;
+    const size_t regsize = datasize == 64 ? 64 : 32;
+
+    const IR::U64 address = AtomicAddress(v, Rn);
+
+    const IR::UAny comparevalue = v.X(datasize, Rs);
+    const IR::UAny newvalue = v.X(datasize, Rt);
+    const IR::UAny data = v.ir.AtomicCompareAndSwapMemory(address, comparevalue, newvalue);
+
+    v.X(regsize, Rs, v.ZeroExtend(data, regsize));
+    return true;
+}
+
+bool TranslatorVisitor::CASB(bool, Reg Rs, bool, Reg Rn, Reg Rt) {
+    return CompareAndSwap(*this, 0, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::CASH(bool, Reg Rs, bool, Reg Rn, Reg Rt) {
+    return CompareAndSwap(*this, 1, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::CAS(bool sz, bool, Reg Rs, bool, Reg Rn, Reg Rt) {
+    return CompareAndSwap(*this, sz ? 3 : 2, Rs, Rn, Rt);
+}
+
+bool TranslatorVisitor::CASP(bool sz, bool, Reg Rs, bool, Reg Rn, Reg Rt) {
+    if (static_cast<size_t>(Rs) % 2 != 0 || static_cast<size_t>(Rt) % 2 != 0) {
+        return UnallocatedEncoding();
+    }
+
+    const IR::U64 address = AtomicAddress(*this, Rn);
+
+    if (!sz) {
+        const IR::U64 comparevalue = ir.Pack2x32To1x64(X(32, Rs), X(32, Rs + 1));
+        const IR::U64 newvalue = ir.Pack2x32To1x64(X(32, Rt), X(32, Rt + 1));
+        const IR::U64 data{ir.AtomicCompareAndSwapMemory(address, comparevalue, newvalue)};
+
+        X(32, Rs, ir.LeastSignificantWord(data));
+        X(32, Rs + 1, ir.MostSignificantWord(data).result);
+    } else {
+        const IR::U128 comparevalue = ir.Pack2x64To1x128(X(64, Rs), X(64, Rs + 1));
+        const IR::U128 newvalue = ir.Pack2x64To1x128(X(64, Rt), X(64, Rt + 1));
+        const IR::U128 data{ir.AtomicCompareAndSwapMemory(address, comparevalue, newvalue)};
+
+        X(64, Rs, ir.VectorGetElement(64, data, 0));
+        X(64, Rs + 1, ir.VectorGetElement(64, data, 1));
+    }
+
+    return true;
+}
+
+} // namespace Dynarmic::A64
@@ -15,10 +15,12 @@ namespace Dynarmic::A64 {
 IR::Block Translate(LocationDescriptor descriptor, MemoryReadCodeFuncType memory_read_code,
                     TranslationOptions options) {
     const bool single_step = descriptor.SingleStepping();
+    const size_t max_instructions = single_step ? 1 : options.max_instructions;
 
     IR::Block block{descriptor};
     TranslatorVisitor visitor{block, descriptor, std::move(options)};
 
+    size_t instruction_count = 0;
     bool should_continue = true;
     do {
         const u64 pc = visitor.ir.current_location->PC();
@@ -32,10 +34,15 @@ IR::Block Translate(LocationDescriptor descriptor, MemoryReadCodeFuncType memory
 
         visitor.ir.current_location = visitor.ir.current_location->AdvancePC(4);
         block.CycleCount()++;
-    } while (should_continue && !single_step);
+        instruction_count++;
+    } while (should_continue && instruction_count != max_instructions);
 
-    if (single_step && should_continue) {
-        visitor.ir.SetTerm(IR::Term::LinkBlock{*visitor.ir.current_location});
+    if (should_continue) {
+        if (single_step) {
+            visitor.ir.SetTerm(IR::Term::LinkBlock{*visitor.ir.current_location});
+        } else {
+            visitor.ir.SetTerm(IR::Term::LinkBlockFast{*visitor.ir.current_location});
+        }
     }
 
     ASSERT_MSG(block.HasTerminal(), "Terminal has not been set");
@@ -34,6 +34,11 @@ struct TranslationOptions {
     /// If this is false, we treat the instruction as a NOP.
     /// If this is true, we emit an ExceptionRaised instruction.
     bool hook_hint_instructions = true;
+
+    /// This limits the number of instructions translated into a single block. A block which
+    /// reaches this limit ends by linking to the block containing the next instruction.
+    /// If this is 0, blocks are not limited in length.
+    size_t max_instructions = 0;
 };
 
 /**
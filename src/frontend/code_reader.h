@@ -0,0 +1,53 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#pragma once
+
+#include <cstring>
+#include <optional>
+
+#include "common/common_types.h"
+
+namespace Dynarmic {
+
+/**
+ * CodeReader reads guest code for the translators on behalf of the user's callbacks.
+ *
+ * If UserCallbacks::GetCodePointer provides a host pointer to a page of guest code, instructions
+ * within that page are read directly from host memory. The user's callbacks are then called once
+ * per page instead of once per instruction. Otherwise UserCallbacks::MemoryReadCode is used.
+ */
+template <typename UserCallbacks, typename VAddr>
+class CodeReader {
+public:
+    static constexpr VAddr page_bits = 12;
+    static constexpr VAddr page_mask = (VAddr(1) << page_bits) - 1;
+
+    explicit CodeReader(UserCallbacks* cb) : cb(cb) {}
+
+    /// Reads four bytes of code. vaddr must be 4-byte aligned.
+    u32 operator()(VAddr vaddr) {
+        const VAddr page = vaddr & ~page_mask;
+        if (page != current_page) {
+            current_page = page;
+            current_pointer = cb->GetCodePointer(page);
+        }
+
+        if (!current_pointer) {
+            return cb->MemoryReadCode(vaddr);
+        }
+
+        u32 instruction;
+        std::memcpy(&instruction, current_pointer + (vaddr & page_mask), sizeof(instruction));
+        return instruction;
+    }
+
+private:
+    UserCallbacks* cb;
+    std::optional<VAddr> current_page;
+    const u8* current_pointer = nullptr;
+};
+
+} // namespace Dynarmic
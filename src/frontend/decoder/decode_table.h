@@ -0,0 +1,38 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#pragma once
+
+#include <vector>
+
+namespace Dynarmic::Decoder {
+
+/**
+ * Buckets a list of matchers by a subset of instruction bits.
+ *
+ * @tparam TableT  An array of vectors of matchers, one vector per bucket.
+ * @param matchers Matchers in priority order.
+ * @param index_fn Gathers a fixed subset of the bits of an opcode into a bucket index.
+ *
+ * Each bucket contains every matcher which could match an instruction with that index, in the
+ * same order as in `matchers`. Scanning a single bucket thus finds the same matcher as scanning
+ * the whole list would.
+ */
+template <typename TableT, typename MatcherT, typename IndexFn>
+TableT GetDecodeTable(const std::vector<MatcherT>& matchers, IndexFn index_fn) {
+    TableT table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        for (const auto& matcher : matchers) {
+            const auto expect = index_fn(matcher.GetExpected());
+            const auto mask = index_fn(matcher.GetMask());
+            if ((i & mask) == expect) {
+                table[i].push_back(matcher);
+            }
+        }
+    }
+    return table;
+}
+
+} // namespace Dynarmic::Decoder
@@ -30,6 +30,7 @@ private:
 
     static constexpr size_t opcode_bitsize = Common::BitSize<opcode_type>();
 
+public:
     /**
      * Generates the mask and the expected value after masking from a given bitstring.
      * A '0' in a bitstring indicates that a zero must be present at that bit position.
@@ -62,7 +63,7 @@ private:
      * An argument is specified by a continuous string of the same character.
      */
     template <size_t N>
-    static auto GetArgInfo(const char* const bitstring) {
+    static constexpr auto GetArgInfo(const char* const bitstring) {
         const auto one = static_cast<opcode_type>(1);
         std::array<opcode_type, N> masks = {};
         std::array<size_t, N> shifts = {};
@@ -91,11 +92,14 @@ private:
             }
         }
 
-        ASSERT(std::all_of(masks.begin(), masks.end(), [](auto m) { return m != 0; }));
+        for (size_t i = 0; i < N; i++) {
+            ASSERT(masks[i] != 0);
+        }
 
         return std::make_tuple(masks, shifts);
     }
 
+private:
     /**
      * This struct's Make member function generates a lambda which decodes an instruction based on
      * the provided arg_masks and arg_shifts. The Visitor member function to call is provided as a
@@ -20,30 +20,36 @@ namespace Dynarmic::Decoder {
  *
  * @tparam OpcodeType Type representing an opcode. This must be the
  *                    type of the second parameter in a handler function.
+ *
+ * @tparam HandlerFunction Type of the handler. Matchers with plain function
+ *                         pointer handlers may be constructed at compile time.
  */
-template <typename Visitor, typename OpcodeType>
+template <typename Visitor, typename OpcodeType,
+          typename HandlerFunction =
+              std::function<typename Visitor::instruction_return_type(Visitor&, OpcodeType)>>
 class Matcher {
 public:
     using opcode_type = OpcodeType;
     using visitor_type = Visitor;
     using handler_return_type = typename Visitor::instruction_return_type;
-    using handler_function = std::function<handler_return_type(Visitor&, opcode_type)>;
+    using handler_function = HandlerFunction;
 
-    Matcher(const char* const name, opcode_type mask, opcode_type expected, handler_function func)
+    constexpr Matcher(const char* const name, opcode_type mask, opcode_type expected,
+                      handler_function func)
         : name{name}, mask{mask}, expected{expected}, fn{std::move(func)} {}
 
     /// Gets the name of this type of instruction.
-    const char* GetName() const {
+    constexpr const char* GetName() const {
         return name;
     }
 
     /// Gets the mask for this instruction.
-    opcode_type GetMask() const {
+    constexpr opcode_type GetMask() const {
         return mask;
     }
 
     /// Gets the expected value after masking for this instruction.
-    opcode_type GetExpected() const {
+    constexpr opcode_type GetExpected() const {
         return expected;
     }
 
@@ -52,7 +58,7 @@ public:
      * @param instruction The instruction to test
      * @returns true if the given instruction matches.
      */
-    bool Matches(opcode_type instruction) const {
+    constexpr bool Matches(opcode_type instruction) const {
         return (instruction & mask) == expected;
     }
 
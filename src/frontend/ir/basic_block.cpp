@@ -21,9 +21,60 @@
 
 namespace Dynarmic::IR {
 
+namespace {
+
+/**
+ * Instruction pools of destroyed blocks are kept for reuse by the next blocks constructed on the
+ * same thread, so translating and compiling a block does not allocate once a pool has grown large
+ * enough. Each pool belongs to a single block while in use, so a block may be destroyed on any
+ * thread.
+ */
+class PoolCache {
+public:
+    Common::Pool* Acquire() {
+        if (pools.empty()) {
+            return new Common::Pool(sizeof(Inst), 4096);
+        }
+        Common::Pool* pool = pools.back().release();
+        pools.pop_back();
+        return pool;
+    }
+
+    void Release(Common::Pool* pool) {
+        // Trim the pool so that one unusually large block does not pin its memory indefinitely.
+        pool->Reset(max_retained_slabs);
+        if (pools.size() == max_cached_pools) {
+            delete pool;
+            return;
+        }
+        pools.emplace_back(pool);
+    }
+
+    static PoolCache& Get() {
+        thread_local PoolCache cache;
+        return cache;
+    }
+
+private:
+    PoolCache() {
+        pools.reserve(max_cached_pools);
+    }
+
+    static constexpr size_t max_cached_pools = 4;
+    static constexpr size_t max_retained_slabs = 1;
+
+    std::vector<std::unique_ptr<Common::Pool>> pools;
+};
+
+} // anonymous namespace
+
+void Block::PoolDeleter::operator()(Common::Pool* pool) const {
+    PoolCache::Get().Release(pool);
+}
+
 Block::Block(const LocationDescriptor& location)
     : location{location}, end_location{location}, cond{Cond::AL},
-      instruction_alloc_pool{std::make_unique<Common::Pool>(sizeof(Inst), 4096)} {}
+      instruction_alloc_pool{PoolCache::Get().Acquire()} {}
 
 Block::~Block() = default;
 
@@ -60,6 +111,15 @@ void Block::SetEndLocation(const LocationDescriptor& descriptor) {
     end_location = descriptor;
 }
 
+void Block::AddCodeDependency(const LocationDescriptor& start, const LocationDescriptor& end) {
+    code_dependencies.emplace_back(start, end);
+}
+
+const std::vector<std::pair<LocationDescriptor, LocationDescriptor>>&
+Block::CodeDependencies() const {
+    return code_dependencies;
+}
+
 Cond Block::GetCondition() const {
     return cond;
 }
@@ -9,6 +9,8 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/intrusive_list.h"
@@ -24,7 +26,7 @@ class Pool;
 namespace Dynarmic::IR {
 
 enum class Cond;
-enum class Opcode;
+enum class Opcode : u16;
 
 /**
  * A basic block. It consists of zero or more instructions followed by exactly one terminal.
@@ -138,6 +140,12 @@ public:
     /// Sets the end location for this basic block.
     void SetEndLocation(const LocationDescriptor& descriptor);
 
+    /// Records that this block was optimized using the guest code of the block from start up to
+    /// end, so that changes to that code must also invalidate this block.
+    void AddCodeDependency(const LocationDescriptor& start, const LocationDescriptor& end);
+    /// Gets the code ranges, other than its own, on which this basic block depends.
+    const std::vector<std::pair<LocationDescriptor, LocationDescriptor>>& CodeDependencies() const;
+
     /// Gets the condition required to pass in order to execute this block.
     Cond GetCondition() const;
     /// Sets the condition required to pass in order to execute this block.
@@ -175,10 +183,16 @@ public:
     const size_t& CycleCount() const;
 
 private:
+    struct PoolDeleter {
+        void operator()(Common::Pool* pool) const;
+    };
+
     /// Description of the starting location of this block
     LocationDescriptor location;
     /// Description of the end location of this block
     LocationDescriptor end_location;
+    /// Code ranges of other blocks on which the optimization of this block depends
+    std::vector<std::pair<LocationDescriptor, LocationDescriptor>> code_dependencies;
     /// Conditional to pass in order to execute this block
     Cond cond;
     /// Block to execute next if `cond` did not pass.
@@ -189,7 +203,7 @@ private:
     /// List of instructions in this block.
     InstructionList instructions;
     /// Memory pool for instruction list
-    std::unique_ptr<Common::Pool> instruction_alloc_pool;
+    std::unique_ptr<Common::Pool, PoolDeleter> instruction_alloc_pool;
     /// Terminal instruction of this block.
     Terminal terminal = Term::Invalid{};
 
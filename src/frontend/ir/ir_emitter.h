@@ -24,7 +24,7 @@ enum class RoundingMode;
 
 namespace Dynarmic::IR {
 
-enum class Opcode;
+enum class Opcode : u16;
 
 template <typename T>
 struct ResultAndCarry {
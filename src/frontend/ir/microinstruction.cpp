@@ -59,11 +59,18 @@ bool Inst::IsSharedMemoryRead() const {
     case Opcode::A32ReadMemory16:
     case Opcode::A32ReadMemory32:
     case Opcode::A32ReadMemory64:
+    case Opcode::A32ReadMemoryPair32:
     case Opcode::A64ReadMemory8:
     case Opcode::A64ReadMemory16:
     case Opcode::A64ReadMemory32:
     case Opcode::A64ReadMemory64:
     case Opcode::A64ReadMemory128:
+    case Opcode::A64ReadMemoryPair32:
+    case Opcode::A64ReadMemoryPair64:
+    case Opcode::A64ReadMemoryViaPage8:
+    case Opcode::A64ReadMemoryViaPage16:
+    case Opcode::A64ReadMemoryViaPage32:
+    case Opcode::A64ReadMemoryViaPage64:
         return true;
 
     default:
@@ -77,11 +84,18 @@ bool Inst::IsSharedMemoryWrite() const {
     case Opcode::A32WriteMemory16:
     case Opcode::A32WriteMemory32:
     case Opcode::A32WriteMemory64:
+    case Opcode::A32WriteMemoryPair32:
     case Opcode::A64WriteMemory8:
     case Opcode::A64WriteMemory16:
     case Opcode::A64WriteMemory32:
     case Opcode::A64WriteMemory64:
     case Opcode::A64WriteMemory128:
+    case Opcode::A64WriteMemoryPair32:
+    case Opcode::A64WriteMemoryPair64:
+    case Opcode::A64WriteMemoryViaPage8:
+    case Opcode::A64WriteMemoryViaPage16:
+    case Opcode::A64WriteMemoryViaPage32:
+    case Opcode::A64WriteMemoryViaPage64:
         return true;
 
     default:
@@ -125,12 +139,62 @@ bool Inst::IsExclusiveMemoryWrite() const {
     }
 }
 
+bool Inst::IsAtomicMemoryOperation() const {
+    switch (op) {
+    case Opcode::A64AtomicSwapMemory8:
+    case Opcode::A64AtomicSwapMemory16:
+    case Opcode::A64AtomicSwapMemory32:
+    case Opcode::A64AtomicSwapMemory64:
+    case Opcode::A64AtomicAddMemory8:
+    case Opcode::A64AtomicAddMemory16:
+    case Opcode::A64AtomicAddMemory32:
+    case Opcode::A64AtomicAddMemory64:
+    case Opcode::A64AtomicAndMemory8:
+    case Opcode::A64AtomicAndMemory16:
+    case Opcode::A64AtomicAndMemory32:
+    case Opcode::A64AtomicAndMemory64:
+    case Opcode::A64AtomicOrMemory8:
+    case Opcode::A64AtomicOrMemory16:
+    case Opcode::A64AtomicOrMemory32:
+    case Opcode::A64AtomicOrMemory64:
+    case Opcode::A64AtomicEorMemory8:
+    case Opcode::A64AtomicEorMemory16:
+    case Opcode::A64AtomicEorMemory32:
+    case Opcode::A64AtomicEorMemory64:
+    case Opcode::A64AtomicSignedMaxMemory8:
+    case Opcode::A64AtomicSignedMaxMemory16:
+    case Opcode::A64AtomicSignedMaxMemory32:
+    case Opcode::A64AtomicSignedMaxMemory64:
+    case Opcode::A64AtomicSignedMinMemory8:
+    case Opcode::A64AtomicSignedMinMemory16:
+    case Opcode::A64AtomicSignedMinMemory32:
+    case Opcode::A64AtomicSignedMinMemory64:
+    case Opcode::A64AtomicUnsignedMaxMemory8:
+    case Opcode::A64AtomicUnsignedMaxMemory16:
+    case Opcode::A64AtomicUnsignedMaxMemory32:
+    case Opcode::A64AtomicUnsignedMaxMemory64:
+    case Opcode::A64AtomicUnsignedMinMemory8:
+    case Opcode::A64AtomicUnsignedMinMemory16:
+    case Opcode::A64AtomicUnsignedMinMemory32:
+    case Opcode::A64AtomicUnsignedMinMemory64:
+    case Opcode::A64AtomicCompareAndSwapMemory8:
+    case Opcode::A64AtomicCompareAndSwapMemory16:
+    case Opcode::A64AtomicCompareAndSwapMemory32:
+    case Opcode::A64AtomicCompareAndSwapMemory64:
+    case Opcode::A64AtomicCompareAndSwapMemory128:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
 bool Inst::IsMemoryRead() const {
-    return IsSharedMemoryRead() || IsExclusiveMemoryRead();
+    return IsSharedMemoryRead() || IsExclusiveMemoryRead() || IsAtomicMemoryOperation();
 }
 
 bool Inst::IsMemoryWrite() const {
-    return IsSharedMemoryWrite() || IsExclusiveMemoryWrite();
+    return IsSharedMemoryWrite() || IsExclusiveMemoryWrite() || IsAtomicMemoryOperation();
 }
 
 bool Inst::IsMemoryReadOrWrite() const {
@@ -547,35 +611,19 @@ bool Inst::AreAllArgsImmediates() const {
 }
 
 bool Inst::HasAssociatedPseudoOperation() const {
-    return carry_inst || overflow_inst || ge_inst || nzcv_inst || upper_inst || lower_inst;
+    return !IsAPseudoOperation() && pseudo_op_list;
 }
 
 Inst* Inst::GetAssociatedPseudoOperation(Opcode opcode) {
+    ASSERT_MSG(!IsAPseudoOperation(), "Pseudo-operations do not have pseudo-operations");
+
     // This is faster than doing a search through the block.
-    switch (opcode) {
-    case Opcode::GetCarryFromOp:
-        ASSERT(!carry_inst || carry_inst->GetOpcode() == Opcode::GetCarryFromOp);
-        return carry_inst;
-    case Opcode::GetOverflowFromOp:
-        ASSERT(!overflow_inst || overflow_inst->GetOpcode() == Opcode::GetOverflowFromOp);
-        return overflow_inst;
-    case Opcode::GetGEFromOp:
-        ASSERT(!ge_inst || ge_inst->GetOpcode() == Opcode::GetGEFromOp);
-        return ge_inst;
-    case Opcode::GetNZCVFromOp:
-        ASSERT(!nzcv_inst || nzcv_inst->GetOpcode() == Opcode::GetNZCVFromOp);
-        return nzcv_inst;
-    case Opcode::GetUpperFromOp:
-        ASSERT(!upper_inst || upper_inst->GetOpcode() == Opcode::GetUpperFromOp);
-        return upper_inst;
-    case Opcode::GetLowerFromOp:
-        ASSERT(!lower_inst || lower_inst->GetOpcode() == Opcode::GetLowerFromOp);
-        return lower_inst;
-    default:
-        break;
+    for (Inst* pseudo_op = pseudo_op_list; pseudo_op; pseudo_op = pseudo_op->next_pseudo_op) {
+        if (pseudo_op->GetOpcode() == opcode) {
+            return pseudo_op;
+        }
     }
-
-    ASSERT_FALSE("Not a valid pseudo-operation");
+    return nullptr;
 }
 
 Type Inst::GetType() const {
@@ -641,71 +689,37 @@ void Inst::ReplaceUsesWith(Value replacement) {
 }
 
 void Inst::Use(const Value& value) {
-    value.GetInst()->use_count++;
+    Inst* const parent = value.GetInst();
+    parent->use_count++;
 
-    switch (op) {
-    case Opcode::GetCarryFromOp:
-        ASSERT_MSG(!value.GetInst()->carry_inst, "Only one of each type of pseudo-op allowed");
-        value.GetInst()->carry_inst = this;
-        break;
-    case Opcode::GetOverflowFromOp:
-        ASSERT_MSG(!value.GetInst()->overflow_inst, "Only one of each type of pseudo-op allowed");
-        value.GetInst()->overflow_inst = this;
-        break;
-    case Opcode::GetGEFromOp:
-        ASSERT_MSG(!value.GetInst()->ge_inst, "Only one of each type of pseudo-op allowed");
-        value.GetInst()->ge_inst = this;
-        break;
-    case Opcode::GetNZCVFromOp:
-        ASSERT_MSG(!value.GetInst()->nzcv_inst, "Only one of each type of pseudo-op allowed");
-        ASSERT_MSG(value.GetInst()->MayGetNZCVFromOp(),
-                   "This value doesn't support the GetNZCVFromOp pseduo-op");
-        value.GetInst()->nzcv_inst = this;
-        break;
-    case Opcode::GetUpperFromOp:
-        ASSERT_MSG(!value.GetInst()->upper_inst, "Only one of each type of pseudo-op allowed");
-        value.GetInst()->upper_inst = this;
-        break;
-    case Opcode::GetLowerFromOp:
-        ASSERT_MSG(!value.GetInst()->lower_inst, "Only one of each type of pseudo-op allowed");
-        value.GetInst()->lower_inst = this;
-        break;
-    default:
-        break;
+    if (!IsAPseudoOperation()) {
+        return;
     }
+
+    ASSERT_MSG(!parent->GetAssociatedPseudoOperation(op),
+               "Only one of each type of pseudo-op allowed");
+    ASSERT_MSG(op != Opcode::GetNZCVFromOp || parent->MayGetNZCVFromOp(),
+               "This value doesn't support the GetNZCVFromOp pseduo-op");
+
+    next_pseudo_op = parent->pseudo_op_list;
+    parent->pseudo_op_list = this;
 }
 
 void Inst::UndoUse(const Value& value) {
-    value.GetInst()->use_count--;
+    Inst* const parent = value.GetInst();
+    parent->use_count--;
 
-    switch (op) {
-    case Opcode::GetCarryFromOp:
-        ASSERT(value.GetInst()->carry_inst->GetOpcode() == Opcode::GetCarryFromOp);
-        value.GetInst()->carry_inst = nullptr;
-        break;
-    case Opcode::GetOverflowFromOp:
-        ASSERT(value.GetInst()->overflow_inst->GetOpcode() == Opcode::GetOverflowFromOp);
-        value.GetInst()->overflow_inst = nullptr;
-        break;
-    case Opcode::GetGEFromOp:
-        ASSERT(value.GetInst()->ge_inst->GetOpcode() == Opcode::GetGEFromOp);
-        value.GetInst()->ge_inst = nullptr;
-        break;
-    case Opcode::GetNZCVFromOp:
-        ASSERT(value.GetInst()->nzcv_inst->GetOpcode() == Opcode::GetNZCVFromOp);
-        value.GetInst()->nzcv_inst = nullptr;
-        break;
-    case Opcode::GetUpperFromOp:
-        ASSERT(value.GetInst()->upper_inst->GetOpcode() == Opcode::GetUpperFromOp);
-        value.GetInst()->upper_inst = nullptr;
-        break;
-    case Opcode::GetLowerFromOp:
-        ASSERT(value.GetInst()->lower_inst->GetOpcode() == Opcode::GetLowerFromOp);
-        value.GetInst()->lower_inst = nullptr;
-        break;
-    default:
-        break;
+    if (!IsAPseudoOperation()) {
+        return;
+    }
+
+    Inst** link = &parent->pseudo_op_list;
+    while (*link != this) {
+        ASSERT(*link);
+        link = &(*link)->next_pseudo_op;
     }
+    *link = next_pseudo_op;
+    next_pseudo_op = nullptr;
 }
 
 } // namespace Dynarmic::IR
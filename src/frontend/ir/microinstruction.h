@@ -13,7 +13,7 @@
 
 namespace Dynarmic::IR {
 
-enum class Opcode;
+enum class Opcode : u16;
 enum class Type;
 
 constexpr size_t max_arg_count = 4;
@@ -48,6 +48,8 @@ public:
     bool IsExclusiveMemoryRead() const;
     /// Determines whether or not this instruction performs an atomic memory write.
     bool IsExclusiveMemoryWrite() const;
+    /// Determines whether or not this instruction performs an atomic read-modify-write.
+    bool IsAtomicMemoryOperation() const;
 
     /// Determines whether or not this instruction performs any kind of memory read.
     bool IsMemoryRead() const;
@@ -150,22 +152,18 @@ private:
     void Use(const Value& value);
     void UndoUse(const Value& value);
 
+    // Members are ordered so as to pack tightly after the intrusive list node.
     Opcode op;
-    size_t use_count = 0;
+    u32 use_count = 0;
     std::array<Value, max_arg_count> args;
 
-    // Pointers to related pseudooperations:
-    // Since not all combinations are possible, we use a union to save space
+    // Pseudo-operations associated with an instruction form a singly-linked list. An instruction
+    // rarely has more than one, so this takes less space than a pointer per kind of pseudo-op.
     union {
-        Inst* carry_inst = nullptr;
-        Inst* ge_inst;
-        Inst* upper_inst;
-    };
-    Inst* overflow_inst = nullptr;
-    union {
-        Inst* nzcv_inst = nullptr;
-        Inst* lower_inst;
+        Inst* pseudo_op_list = nullptr; // Head of this instruction's list of pseudo-operations
+        Inst* next_pseudo_op;           // Next in the parent's list, if this is a pseudo-operation
     };
 };
+static_assert(sizeof(Inst) <= 96, "IR::Inst should be kept small in size");
 
 } // namespace Dynarmic::IR
@@ -4,13 +4,15 @@
  */
 
 #include <array>
+#include <initializer_list>
 #include <ostream>
 #include <string>
-#include <vector>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include "common/assert.h"
+#include "frontend/ir/microinstruction.h"
 #include "frontend/ir/opcodes.h"
 #include "frontend/ir/type.h"
 
@@ -20,12 +22,6 @@ namespace Dynarmic::IR {
 
 namespace OpcodeInfo {
 
-struct Meta {
-    const char* name;
-    Type type;
-    std::vector<Type> arg_types;
-};
-
 constexpr Type Void = Type::Void;
 constexpr Type A32Reg = Type::A32Reg;
 constexpr Type A32ExtReg = Type::A32ExtReg;
@@ -43,32 +39,74 @@ constexpr Type NZCV = Type::NZCVFlags;
 constexpr Type Cond = Type::Cond;
 constexpr Type Table = Type::Table;
 
-static const std::array opcode_info{
-#define OPCODE(name, type, ...) Meta{#name, type, {__VA_ARGS__}},
-#define A32OPC(name, type, ...) Meta{#name, type, {__VA_ARGS__}},
-#define A64OPC(name, type, ...) Meta{#name, type, {__VA_ARGS__}},
+struct ArgTypes {
+    size_t count;
+    std::array<Type, max_arg_count> types;
+};
+
+constexpr ArgTypes Args(std::initializer_list<Type> types) {
+    ArgTypes result{types.size(), {}};
+    for (size_t i = 0; i < types.size(); i++) {
+        result.types[i] = types.begin()[i];
+    }
+    return result;
+}
+
+// Opcode information is kept in separate tables, as the return and argument types are queried far
+// more frequently than the names.
+
+constexpr std::array opcode_names{
+#define OPCODE(name, type, ...) #name,
+#define A32OPC(name, type, ...) #name,
+#define A64OPC(name, type, ...) #name,
+#include "opcodes.inc"
+#undef OPCODE
+#undef A32OPC
+#undef A64OPC
+};
+
+constexpr std::array opcode_types{
+#define OPCODE(name, type, ...) type,
+#define A32OPC(name, type, ...) type,
+#define A64OPC(name, type, ...) type,
+#include "opcodes.inc"
+#undef OPCODE
+#undef A32OPC
+#undef A64OPC
+};
+
+constexpr std::array opcode_arg_types{
+#define OPCODE(name, type, ...) Args({__VA_ARGS__}),
+#define A32OPC(name, type, ...) Args({__VA_ARGS__}),
+#define A64OPC(name, type, ...) Args({__VA_ARGS__}),
 #include "opcodes.inc"
 #undef OPCODE
 #undef A32OPC
 #undef A64OPC
 };
 
+static_assert(opcode_names.size() == OpcodeCount);
+static_assert(opcode_types.size() == OpcodeCount);
+static_assert(opcode_arg_types.size() == OpcodeCount);
+
 } // namespace OpcodeInfo
 
 Type GetTypeOf(Opcode op) {
-    return OpcodeInfo::opcode_info.at(static_cast<size_t>(op)).type;
+    return OpcodeInfo::opcode_types[static_cast<size_t>(op)];
 }
 
 size_t GetNumArgsOf(Opcode op) {
-    return OpcodeInfo::opcode_info.at(static_cast<size_t>(op)).arg_types.size();
+    return OpcodeInfo::opcode_arg_types[static_cast<size_t>(op)].count;
 }
 
 Type GetArgTypeOf(Opcode op, size_t arg_index) {
-    return OpcodeInfo::opcode_info.at(static_cast<size_t>(op)).arg_types.at(arg_index);
+    const auto& arg_types = OpcodeInfo::opcode_arg_types[static_cast<size_t>(op)];
+    ASSERT(arg_index < arg_types.count);
+    return arg_types.types[arg_index];
 }
 
 std::string GetNameOf(Opcode op) {
-    return OpcodeInfo::opcode_info.at(static_cast<size_t>(op)).name;
+    return OpcodeInfo::opcode_names[static_cast<size_t>(op)];
 }
 
 } // namespace Dynarmic::IR
@@ -0,0 +1,160 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <utility>
+#include <vector>
+
+#include <boost/variant/get.hpp>
+#include <dynarmic/A32/config.h>
+
+#include "common/common_types.h"
+#include "frontend/A32/location_descriptor.h"
+#include "frontend/A32/translate/translate.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+/// Start and end locations of the successor blocks that were translated to analyze a block.
+using CodeRanges = std::vector<std::pair<IR::LocationDescriptor, IR::LocationDescriptor>>;
+
+// Bitmasks of individual NZCV flags.
+constexpr u32 flag_n = 0b1000;
+constexpr u32 flag_z = 0b0100;
+constexpr u32 flag_c = 0b0010;
+constexpr u32 flag_v = 0b0001;
+constexpr u32 flag_nzcv = 0b1111;
+
+u32 FlagsRead(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::A32GetNFlag:
+        return flag_n;
+    case IR::Opcode::A32GetZFlag:
+        return flag_z;
+    case IR::Opcode::A32GetCFlag:
+        return flag_c;
+    case IR::Opcode::A32GetVFlag:
+        return flag_v;
+    default:
+        return inst.ReadsFromCPSR() || inst.CausesCPUException() ? flag_nzcv : 0;
+    }
+}
+
+u32 FlagsWritten(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::A32SetNFlag:
+        return flag_n;
+    case IR::Opcode::A32SetZFlag:
+        return flag_z;
+    case IR::Opcode::A32SetCFlag:
+        return flag_c;
+    case IR::Opcode::A32SetVFlag:
+        return flag_v;
+    case IR::Opcode::A32SetCpsr:
+    case IR::Opcode::A32SetCpsrNZCV:
+    case IR::Opcode::A32SetCpsrNZCVRaw:
+    case IR::Opcode::A32SetCpsrNZCVQ:
+        return flag_nzcv;
+    default:
+        return 0;
+    }
+}
+
+/// Instructions that write nothing but NZCV flags, and can therefore be removed when dead.
+bool IsRemovableFlagWrite(const IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case IR::Opcode::A32SetNFlag:
+    case IR::Opcode::A32SetZFlag:
+    case IR::Opcode::A32SetCFlag:
+    case IR::Opcode::A32SetVFlag:
+    case IR::Opcode::A32SetCpsrNZCV:
+    case IR::Opcode::A32SetCpsrNZCVRaw:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Flags that the block starting at location overwrites before anything can observe them.
+u32 FlagsOverwritten(const A32::UserConfig& conf, A32::LocationDescriptor location,
+                     CodeRanges& analyzed) {
+    const auto get_code = [&conf](u32 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); };
+    const IR::Block block =
+        A32::Translate(location, get_code,
+                       {conf.define_unpredictable_behaviour, conf.hook_hint_instructions});
+    analyzed.emplace_back(block.Location(), block.EndLocation());
+
+    if (block.GetCondition() != IR::Cond::AL) {
+        return 0;
+    }
+
+    u32 read = 0;
+    u32 overwritten = 0;
+    for (const auto& inst : block) {
+        read |= FlagsRead(inst) & ~overwritten;
+        overwritten |= FlagsWritten(inst) & ~read;
+    }
+    return overwritten;
+}
+
+/// Flags that are dead on every path out of a block ending with terminal.
+u32 FlagsDeadAfter(const A32::UserConfig& conf, const IR::Terminal& terminal,
+                   CodeRanges& analyzed) {
+    if (const auto term = boost::get<IR::Term::LinkBlock>(&terminal)) {
+        return FlagsOverwritten(conf, A32::LocationDescriptor{term->next}, analyzed);
+    }
+    if (const auto term = boost::get<IR::Term::LinkBlockFast>(&terminal)) {
+        return FlagsOverwritten(conf, A32::LocationDescriptor{term->next}, analyzed);
+    }
+    if (const auto term = boost::get<IR::Term::CheckBit>(&terminal)) {
+        return FlagsDeadAfter(conf, term->then_, analyzed) &
+               FlagsDeadAfter(conf, term->else_, analyzed);
+    }
+    if (const auto term = boost::get<IR::Term::CheckHalt>(&terminal)) {
+        return FlagsDeadAfter(conf, term->else_, analyzed);
+    }
+
+    // If terminals read the flags. We know nothing about the successors of indirect exits.
+    return 0;
+}
+
+} // anonymous namespace
+
+void A32DeadFlagElimination(IR::Block& block, const A32::UserConfig& conf) {
+    if (A32::LocationDescriptor{block.Location()}.SingleStepping()) {
+        return;
+    }
+
+    CodeRanges analyzed;
+    u32 live = flag_nzcv & ~FlagsDeadAfter(conf, block.GetTerminal(), analyzed);
+    if (live == flag_nzcv) {
+        return;
+    }
+
+    // This block is now only correct while the code of its successors is unchanged.
+    for (const auto& [start, end] : analyzed) {
+        block.AddCodeDependency(start, end);
+    }
+
+    auto iter = block.end();
+    while (iter != block.begin()) {
+        --iter;
+
+        const u32 written = FlagsWritten(*iter);
+        if (IsRemovableFlagWrite(*iter) && (written & live) == 0) {
+            // The flag computation feeding this write is removed by dead code elimination.
+            iter->Invalidate();
+            iter = block.Instructions().erase(iter);
+            continue;
+        }
+
+        live = (live & ~written) | FlagsRead(*iter);
+    }
+}
+
+} // namespace Dynarmic::Optimization
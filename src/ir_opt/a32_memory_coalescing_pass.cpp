@@ -0,0 +1,67 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <dynarmic/A32/config.h>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "frontend/A32/ir_emitter.h"
+#include "frontend/A32/location_descriptor.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/memory_address.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+void A32MemoryCoalescing(IR::Block& block, const A32::UserConfig& conf) {
+    // Fastmem accesses have no lookup to share, and callback-only setups have no inline path.
+    const bool has_vaddr_lookup = conf.page_table || conf.flat_memory_base ||
+                                  conf.enable_software_tlb;
+    if (!has_vaddr_lookup || (conf.page_table && conf.fastmem_pointer)) {
+        return;
+    }
+
+    A32::IREmitter ir{block, A32::LocationDescriptor{block.Location()}};
+
+    for (auto iter = block.begin(); iter != block.end(); ++iter) {
+        IR::Inst& first = *iter;
+
+        const IR::Opcode opcode = first.GetOpcode();
+        if (opcode != IR::Opcode::A32ReadMemory32 && opcode != IR::Opcode::A32WriteMemory32) {
+            continue;
+        }
+
+        IR::Inst* const second = FindNextMemoryAccess(iter, block.end());
+        if (!second || second->GetOpcode() != opcode) {
+            continue;
+        }
+
+        const Address first_address = DecomposeAddress(first.GetArg(0));
+        const Address second_address = DecomposeAddress(second->GetArg(0));
+        if (!IsAddressAfter(first_address, second_address, 4)) {
+            continue;
+        }
+
+        const IR::U32 vaddr{first.GetArg(0)};
+
+        if (opcode == IR::Opcode::A32ReadMemory32) {
+            ir.SetInsertionPoint(&first);
+            const IR::U64 pair = ir.ReadMemoryPair32(vaddr);
+            first.ReplaceUsesWith(ir.LeastSignificantWord(pair));
+            second->ReplaceUsesWith(ir.MostSignificantWord(pair).result);
+        } else {
+            // Writes are merged at the position of the second write, where both values are
+            // available.
+            ir.SetInsertionPoint(second);
+            ir.WriteMemoryPair32(vaddr, IR::U32{first.GetArg(1)}, IR::U32{second->GetArg(1)});
+            first.Invalidate();
+            second->Invalidate();
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
@@ -4,7 +4,7 @@
  * General Public License version 2 or any later version.
  */
 
-#include <array>
+#include <optional>
 
 #include <boost/variant/get.hpp>
 
@@ -13,27 +13,62 @@
 #include "dynarmic/A32/config.h"
 #include "frontend/A32/location_descriptor.h"
 #include "frontend/A32/translate/translate.h"
+#include "frontend/code_reader.h"
 #include "frontend/ir/basic_block.h"
 #include "ir_opt/passes.h"
 
 namespace Dynarmic::Optimization {
 
 void A32MergeInterpretBlocksPass(IR::Block& block, A32::UserCallbacks* cb) {
-    const auto is_interpret_instruction = [cb](A32::LocationDescriptor location) {
-        const u32 instruction = cb->MemoryReadCode(location.PC());
+    // A single step must only execute one instruction.
+    if (A32::LocationDescriptor{block.Location()}.SingleStepping()) {
+        return;
+    }
+
+    CodeReader<A32::UserCallbacks, u32> read_code{cb};
+
+    const auto read_halfword = [&read_code](u32 vaddr) {
+        return static_cast<u16>(read_code(vaddr & ~u32(3)) >> ((vaddr & 2) * 8));
+    };
+
+    // Returns the size of the instruction at location if it would only be interpreted.
+    const auto get_interpret_instruction_size =
+        [&](A32::LocationDescriptor location) -> std::optional<u32> {
+        // The IT state would have to be advanced for each instruction in an IT block.
+        if (location.IT().IsInITBlock()) {
+            return std::nullopt;
+        }
+
+        u32 instruction;
+        u32 size;
+        if (!location.TFlag()) {
+            instruction = read_code(location.PC());
+            size = 4;
+        } else {
+            const u16 first_part = read_halfword(location.PC());
+            if (A32::IsThumb16(first_part)) {
+                instruction = first_part;
+                size = 2;
+            } else {
+                instruction = (u32{first_part} << 16) | read_halfword(location.PC() + 2);
+                size = 4;
+            }
+        }
 
         IR::Block new_block{location};
         A32::TranslateSingleInstruction(new_block, location, instruction);
 
         if (!new_block.Instructions().empty())
-            return false;
+            return std::nullopt;
 
         const IR::Terminal terminal = new_block.GetTerminal();
         if (auto term = boost::get<IR::Term::Interpret>(&terminal)) {
-            return term->next == location;
+            if (term->next == location) {
+                return size;
+            }
         }
 
-        return false;
+        return std::nullopt;
     };
 
     IR::Terminal terminal = block.GetTerminal();
@@ -42,9 +77,14 @@ void A32MergeInterpretBlocksPass(IR::Block& block, A32::UserCallbacks* cb) {
         return;
 
     A32::LocationDescriptor location{term->next};
-    size_t num_instructions = 1;
+    const std::optional<u32> first_size = get_interpret_instruction_size(location);
+    if (!first_size)
+        return;
 
-    while (is_interpret_instruction(location.AdvancePC(static_cast<int>(num_instructions * 4)))) {
+    size_t num_instructions = 1;
+    location = location.AdvancePC(static_cast<int>(*first_size));
+    while (const std::optional<u32> size = get_interpret_instruction_size(location)) {
+        location = location.AdvancePC(static_cast<int>(*size));
         num_instructions++;
     }
 
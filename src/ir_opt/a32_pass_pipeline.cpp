@@ -0,0 +1,100 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <vector>
+
+#include <dynarmic/A32/config.h>
+#include <fmt/format.h>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "common/fp/fpcr.h"
+#include "frontend/A32/location_descriptor.h"
+#include "frontend/ir/basic_block.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+const std::vector<OptimizationFlag> default_pass_order{
+    OptimizationFlag::GetSetElimination,
+    OptimizationFlag::CrossBlockFlagElimination,
+    OptimizationFlag::DeadCodeElimination,
+    OptimizationFlag::MemoryForwarding,
+    OptimizationFlag::ConstantMemoryReads,
+    OptimizationFlag::FPConstantFolding,
+    OptimizationFlag::AlgebraicSimplification,
+    OptimizationFlag::ConstantPropagation,
+    OptimizationFlag::CommonSubexpressionElimination,
+    OptimizationFlag::MemoryCoalescing,
+    OptimizationFlag::DeadCodeElimination,
+    OptimizationFlag::MergeInterpretBlocks,
+};
+
+void RunPass(IR::Block& block, const A32::UserConfig& conf, OptimizationFlag pass) {
+    switch (pass) {
+    case OptimizationFlag::GetSetElimination:
+        A32GetSetElimination(block);
+        break;
+    case OptimizationFlag::CrossBlockFlagElimination:
+        A32DeadFlagElimination(block, conf);
+        break;
+    case OptimizationFlag::DeadCodeElimination:
+        DeadCodeElimination(block);
+        break;
+    case OptimizationFlag::ConstantPropagation:
+        ConstantPropagation(block);
+        break;
+    case OptimizationFlag::MemoryForwarding:
+        MemoryForwarding(block);
+        break;
+    case OptimizationFlag::ConstantMemoryReads:
+        A32ConstantMemoryReads(block, conf.callbacks);
+        break;
+    case OptimizationFlag::FPConstantFolding:
+        FPConstantFolding(
+            block, FP::FPCR{A32::LocationDescriptor{block.Location()}.FPSCR().Value()});
+        break;
+    case OptimizationFlag::AlgebraicSimplification:
+        AlgebraicSimplification(block);
+        break;
+    case OptimizationFlag::CommonSubexpressionElimination:
+        CommonSubexpressionElimination(block);
+        break;
+    case OptimizationFlag::MergeInterpretBlocks:
+        A32MergeInterpretBlocksPass(block, conf.callbacks);
+        break;
+    case OptimizationFlag::MemoryCoalescing:
+        A32MemoryCoalescing(block, conf);
+        break;
+    case OptimizationFlag::PageLookupSharing:
+        // This pass is not implemented for A32.
+        break;
+    default:
+        ASSERT_FALSE("Invalid IR pass {}", static_cast<u32>(pass));
+    }
+}
+
+} // Anonymous namespace
+
+void A32Optimize(IR::Block& block, const A32::UserConfig& conf) {
+    if (conf.enable_optimizations) {
+        const auto& pass_order = conf.pass_order.empty() ? default_pass_order : conf.pass_order;
+        for (const OptimizationFlag pass : pass_order) {
+            if (conf.HasOptimization(pass)) {
+                RunPass(block, conf, pass);
+            }
+        }
+    }
+    if (conf.HasOptimization(OptimizationFlag::PrintIR)) {
+        fmt::print("{}\n", IR::DumpBlock(block));
+    }
+    if (conf.HasOptimization(OptimizationFlag::Verification)) {
+        VerificationPass(block);
+    }
+}
+
+} // namespace Dynarmic::Optimization
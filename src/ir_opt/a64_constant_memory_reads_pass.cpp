@@ -0,0 +1,76 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2018 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <optional>
+
+#include <dynarmic/A64/config.h>
+
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+/// Returns the value read by inst if it reads from an immediate address in read-only memory.
+template <typename T>
+std::optional<T> ReadConstant(const IR::Inst& inst, A64::UserCallbacks* cb,
+                              T (A64::UserCallbacks::*read)(A64::VAddr)) {
+    if (!inst.AreAllArgsImmediates()) {
+        return std::nullopt;
+    }
+
+    const u64 vaddr = inst.GetArg(0).GetU64();
+    if (!cb->IsReadOnlyMemory(vaddr) || !cb->IsReadOnlyMemory(vaddr + sizeof(T) - 1)) {
+        return std::nullopt;
+    }
+    return (cb->*read)(vaddr);
+}
+
+template <typename T>
+void FoldRead(IR::Inst& inst, A64::UserCallbacks* cb, T (A64::UserCallbacks::*read)(A64::VAddr)) {
+    if (const auto value_from_memory = ReadConstant(inst, cb, read)) {
+        inst.ReplaceUsesWith(IR::Value{*value_from_memory});
+    }
+}
+
+} // anonymous namespace
+
+void A64ConstantMemoryReads(IR::Block& block, A64::UserCallbacks* cb) {
+    for (auto iter = block.begin(); iter != block.end(); ++iter) {
+        auto& inst = *iter;
+
+        switch (inst.GetOpcode()) {
+        case IR::Opcode::A64ReadMemory8:
+            FoldRead(inst, cb, &A64::UserCallbacks::MemoryRead8);
+            break;
+        case IR::Opcode::A64ReadMemory16:
+            FoldRead(inst, cb, &A64::UserCallbacks::MemoryRead16);
+            break;
+        case IR::Opcode::A64ReadMemory32:
+            FoldRead(inst, cb, &A64::UserCallbacks::MemoryRead32);
+            break;
+        case IR::Opcode::A64ReadMemory64:
+            FoldRead(inst, cb, &A64::UserCallbacks::MemoryRead64);
+            break;
+        case IR::Opcode::A64ReadMemory128: {
+            const auto value = ReadConstant(inst, cb, &A64::UserCallbacks::MemoryRead128);
+            if (value) {
+                // There are no 128-bit immediates, so the value is rebuilt from two halves.
+                const auto pack = block.PrependNewInst(iter, IR::Opcode::Pack2x64To1x128,
+                                                       {IR::Value{(*value)[0]},
+                                                        IR::Value{(*value)[1]}});
+                inst.ReplaceUsesWith(IR::Value{&*pack});
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
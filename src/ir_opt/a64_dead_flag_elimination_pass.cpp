@@ -0,0 +1,103 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <utility>
+#include <vector>
+
+#include <boost/variant/get.hpp>
+#include <dynarmic/A64/config.h>
+
+#include "frontend/A64/location_descriptor.h"
+#include "frontend/A64/translate/translate.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+/// Start and end locations of the successor blocks that were translated to analyze a block.
+using CodeRanges = std::vector<std::pair<IR::LocationDescriptor, IR::LocationDescriptor>>;
+
+/// Does the block starting at location overwrite NZCV before anything can observe it?
+bool IsNZCVOverwritten(const A64::UserConfig& conf, A64::LocationDescriptor location,
+                       CodeRanges& analyzed) {
+    const auto get_code = [&conf](u64 vaddr) { return conf.callbacks->MemoryReadCode(vaddr); };
+    A64::TranslationOptions options{conf.define_unpredictable_behaviour, conf.wall_clock_cntpct};
+    options.max_instructions = conf.max_instructions_per_block;
+    const IR::Block block = A64::Translate(location, get_code, options);
+    analyzed.emplace_back(block.Location(), block.EndLocation());
+
+    for (const auto& inst : block) {
+        if (inst.ReadsFromCPSR() || inst.CausesCPUException()) {
+            return false;
+        }
+        if (inst.WritesToCPSR()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// Is NZCV dead on every path out of a block ending with terminal?
+bool IsNZCVDeadAfter(const A64::UserConfig& conf, const IR::Terminal& terminal,
+                     CodeRanges& analyzed) {
+    if (const auto term = boost::get<IR::Term::LinkBlock>(&terminal)) {
+        return IsNZCVOverwritten(conf, A64::LocationDescriptor{term->next}, analyzed);
+    }
+    if (const auto term = boost::get<IR::Term::LinkBlockFast>(&terminal)) {
+        return IsNZCVOverwritten(conf, A64::LocationDescriptor{term->next}, analyzed);
+    }
+    if (const auto term = boost::get<IR::Term::CheckBit>(&terminal)) {
+        return IsNZCVDeadAfter(conf, term->then_, analyzed) &&
+               IsNZCVDeadAfter(conf, term->else_, analyzed);
+    }
+    if (const auto term = boost::get<IR::Term::CheckHalt>(&terminal)) {
+        return IsNZCVDeadAfter(conf, term->else_, analyzed);
+    }
+
+    // If terminals read the flags. We know nothing about the successors of indirect exits.
+    return false;
+}
+
+} // anonymous namespace
+
+void A64DeadFlagElimination(IR::Block& block, const A64::UserConfig& conf) {
+    if (A64::LocationDescriptor{block.Location()}.SingleStepping()) {
+        return;
+    }
+
+    auto last_write = block.end();
+    for (auto iter = block.begin(); iter != block.end(); ++iter) {
+        if (iter->WritesToCPSR()) {
+            last_write = iter;
+        } else if (last_write != block.end() &&
+                   (iter->ReadsFromCPSR() || iter->CausesCPUException())) {
+            last_write = block.end();
+        }
+    }
+
+    if (last_write == block.end()) {
+        return;
+    }
+
+    CodeRanges analyzed;
+    if (!IsNZCVDeadAfter(conf, block.GetTerminal(), analyzed)) {
+        return;
+    }
+
+    // This block is now only correct while the code of its successors is unchanged.
+    for (const auto& [start, end] : analyzed) {
+        block.AddCodeDependency(start, end);
+    }
+
+    // The flag computation feeding this write is removed by dead code elimination.
+    last_write->Invalidate();
+    block.Instructions().erase(last_write);
+}
+
+} // namespace Dynarmic::Optimization
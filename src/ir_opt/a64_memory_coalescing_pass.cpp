@@ -0,0 +1,102 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <optional>
+
+#include <dynarmic/A64/config.h>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "frontend/A64/ir_emitter.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/memory_address.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+std::optional<size_t> PairableAccessSize(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::A64ReadMemory32:
+    case IR::Opcode::A64WriteMemory32:
+        return 4;
+    case IR::Opcode::A64ReadMemory64:
+    case IR::Opcode::A64WriteMemory64:
+        return 8;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // anonymous namespace
+
+void A64MemoryCoalescing(IR::Block& block, const A64::UserConfig& conf) {
+    // Paired accesses are only emitted inline when the backend can look up host addresses.
+    if (!conf.page_table && !conf.flat_memory_base) {
+        return;
+    }
+
+    A64::IREmitter ir{block};
+
+    for (auto iter = block.begin(); iter != block.end(); ++iter) {
+        IR::Inst& first = *iter;
+
+        const auto size = PairableAccessSize(first.GetOpcode());
+        if (!size) {
+            continue;
+        }
+
+        IR::Inst* const second = FindNextMemoryAccess(iter, block.end());
+        if (!second || second->GetOpcode() != first.GetOpcode()) {
+            continue;
+        }
+
+        const Address first_address = DecomposeAddress(first.GetArg(0));
+        const Address second_address = DecomposeAddress(second->GetArg(0));
+        if (!IsAddressAfter(first_address, second_address, *size)) {
+            continue;
+        }
+
+        const IR::U64 vaddr{first.GetArg(0)};
+
+        switch (first.GetOpcode()) {
+        case IR::Opcode::A64ReadMemory32: {
+            ir.SetInsertionPoint(&first);
+            const IR::U64 pair = ir.ReadMemoryPair32(vaddr);
+            first.ReplaceUsesWith(ir.LeastSignificantWord(pair));
+            second->ReplaceUsesWith(ir.MostSignificantWord(pair).result);
+            break;
+        }
+        case IR::Opcode::A64ReadMemory64: {
+            ir.SetInsertionPoint(&first);
+            const IR::U128 pair = ir.ReadMemoryPair64(vaddr);
+            first.ReplaceUsesWith(ir.VectorGetElement(64, pair, 0));
+            second->ReplaceUsesWith(ir.VectorGetElement(64, pair, 1));
+            break;
+        }
+        case IR::Opcode::A64WriteMemory32:
+            // Writes are merged at the position of the second write, where both values are
+            // available.
+            ir.SetInsertionPoint(second);
+            ir.WriteMemoryPair32(vaddr, IR::U32{first.GetArg(1)}, IR::U32{second->GetArg(1)});
+            first.Invalidate();
+            second->Invalidate();
+            break;
+        case IR::Opcode::A64WriteMemory64:
+            ir.SetInsertionPoint(second);
+            ir.WriteMemoryPair64(vaddr, IR::U64{first.GetArg(1)}, IR::U64{second->GetArg(1)});
+            first.Invalidate();
+            second->Invalidate();
+            break;
+        default:
+            UNREACHABLE();
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
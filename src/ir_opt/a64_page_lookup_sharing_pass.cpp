@@ -0,0 +1,151 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include <dynarmic/A64/config.h>
+
+#include "common/common_types.h"
+#include "frontend/A64/ir_emitter.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/memory_address.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+/// Accesses further apart than this are unlikely to share a page, so are not clustered.
+constexpr u64 max_cluster_span = 256;
+
+struct Cluster {
+    IR::Inst* base;
+    u64 begin;
+    u64 end;
+    std::vector<IR::Inst*> accesses;
+};
+
+std::optional<size_t> AccessBitsize(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::A64ReadMemory8:
+    case IR::Opcode::A64WriteMemory8:
+        return 8;
+    case IR::Opcode::A64ReadMemory16:
+    case IR::Opcode::A64WriteMemory16:
+        return 16;
+    case IR::Opcode::A64ReadMemory32:
+    case IR::Opcode::A64WriteMemory32:
+        return 32;
+    case IR::Opcode::A64ReadMemory64:
+    case IR::Opcode::A64WriteMemory64:
+        return 64;
+    default:
+        return std::nullopt;
+    }
+}
+
+/// Instructions which may run arbitrary host code, during which the page table may be changed.
+bool EndsClusters(const IR::Inst& inst) {
+    return inst.IsBarrier() || inst.AltersExclusiveState() || inst.IsAtomicMemoryOperation() ||
+           inst.CausesCPUException() || inst.IsCoprocessorInstruction() ||
+           inst.GetOpcode() == IR::Opcode::A64DataCacheOperationRaised;
+}
+
+void RewriteCluster(IR::Block& block, const Cluster& cluster) {
+    if (cluster.accesses.size() < 2) {
+        return;
+    }
+
+    A64::IREmitter ir{block};
+    ir.SetInsertionPoint(cluster.accesses.front());
+
+    IR::U64 begin{IR::Value{cluster.base}};
+    if (cluster.begin != 0) {
+        begin = ir.Add(begin, ir.Imm64(cluster.begin));
+    }
+    const IR::U64 host = ir.LookupPage(begin, static_cast<u16>(cluster.end - cluster.begin));
+
+    for (IR::Inst* access : cluster.accesses) {
+        ir.SetInsertionPoint(access);
+
+        const IR::U64 vaddr{access->GetArg(0)};
+        const auto offset = static_cast<u16>(DecomposeAddress(vaddr).offset - cluster.begin);
+        if (access->IsSharedMemoryWrite()) {
+            ir.WriteMemoryViaPage(vaddr, host, offset, IR::UAny{access->GetArg(1)});
+            access->Invalidate();
+        } else {
+            const size_t bitsize = *AccessBitsize(access->GetOpcode());
+            access->ReplaceUsesWith(ir.ReadMemoryViaPage(bitsize, vaddr, host, offset));
+        }
+    }
+}
+
+} // anonymous namespace
+
+void A64PageLookupSharing(IR::Block& block, const A64::UserConfig& conf) {
+    // Shared lookups bypass per-access misalignment detection, so are only used when it is off.
+    if (!conf.page_table || conf.detect_misaligned_access_via_page_table != 0) {
+        return;
+    }
+
+    std::vector<Cluster> clusters;
+    std::vector<Cluster> open_clusters;
+
+    const auto close_all = [&] {
+        clusters.insert(clusters.end(), open_clusters.begin(), open_clusters.end());
+        open_clusters.clear();
+    };
+
+    for (auto& inst : block) {
+        if (EndsClusters(inst)) {
+            close_all();
+            continue;
+        }
+
+        const auto bitsize = AccessBitsize(inst.GetOpcode());
+        if (!bitsize) {
+            continue;
+        }
+
+        const Address address = DecomposeAddress(inst.GetArg(0));
+        if (!address.base) {
+            continue;
+        }
+
+        const u64 begin = address.offset;
+        const u64 end = address.offset + *bitsize / 8;
+
+        const auto iter =
+            std::find_if(open_clusters.begin(), open_clusters.end(),
+                         [&](const Cluster& cluster) { return cluster.base == address.base; });
+        if (iter == open_clusters.end()) {
+            open_clusters.push_back({address.base, begin, end, {&inst}});
+            continue;
+        }
+
+        // Offsets are compared as signed quantities so that negative offsets cluster naturally.
+        const s64 new_begin = std::min<s64>(static_cast<s64>(iter->begin), static_cast<s64>(begin));
+        const s64 new_end = std::max<s64>(static_cast<s64>(iter->end), static_cast<s64>(end));
+        if (static_cast<u64>(new_end - new_begin) > max_cluster_span) {
+            continue;
+        }
+
+        iter->begin = static_cast<u64>(new_begin);
+        iter->end = static_cast<u64>(new_end);
+        iter->accesses.push_back(&inst);
+    }
+
+    close_all();
+
+    for (const Cluster& cluster : clusters) {
+        RewriteCluster(block, cluster);
+    }
+}
+
+} // namespace Dynarmic::Optimization
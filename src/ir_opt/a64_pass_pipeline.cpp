@@ -0,0 +1,100 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <vector>
+
+#include <dynarmic/A64/config.h>
+#include <fmt/format.h>
+
+#include "common/assert.h"
+#include "common/common_types.h"
+#include "frontend/A64/location_descriptor.h"
+#include "frontend/ir/basic_block.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+const std::vector<OptimizationFlag> default_pass_order{
+    OptimizationFlag::GetSetElimination,
+    OptimizationFlag::CrossBlockFlagElimination,
+    OptimizationFlag::DeadCodeElimination,
+    OptimizationFlag::ConstantPropagation,
+    OptimizationFlag::MemoryForwarding,
+    OptimizationFlag::ConstantMemoryReads,
+    OptimizationFlag::FPConstantFolding,
+    OptimizationFlag::AlgebraicSimplification,
+    OptimizationFlag::ConstantPropagation,
+    OptimizationFlag::CommonSubexpressionElimination,
+    OptimizationFlag::MemoryCoalescing,
+    OptimizationFlag::PageLookupSharing,
+    OptimizationFlag::DeadCodeElimination,
+    OptimizationFlag::MergeInterpretBlocks,
+};
+
+void RunPass(IR::Block& block, const A64::UserConfig& conf, OptimizationFlag pass) {
+    switch (pass) {
+    case OptimizationFlag::GetSetElimination:
+        A64GetSetElimination(block);
+        break;
+    case OptimizationFlag::CrossBlockFlagElimination:
+        A64DeadFlagElimination(block, conf);
+        break;
+    case OptimizationFlag::DeadCodeElimination:
+        DeadCodeElimination(block);
+        break;
+    case OptimizationFlag::ConstantPropagation:
+        ConstantPropagation(block);
+        break;
+    case OptimizationFlag::MemoryForwarding:
+        MemoryForwarding(block);
+        break;
+    case OptimizationFlag::ConstantMemoryReads:
+        A64ConstantMemoryReads(block, conf.callbacks);
+        break;
+    case OptimizationFlag::FPConstantFolding:
+        FPConstantFolding(block, A64::LocationDescriptor{block.Location()}.FPCR());
+        break;
+    case OptimizationFlag::AlgebraicSimplification:
+        AlgebraicSimplification(block);
+        break;
+    case OptimizationFlag::CommonSubexpressionElimination:
+        CommonSubexpressionElimination(block);
+        break;
+    case OptimizationFlag::MemoryCoalescing:
+        A64MemoryCoalescing(block, conf);
+        break;
+    case OptimizationFlag::PageLookupSharing:
+        A64PageLookupSharing(block, conf);
+        break;
+    case OptimizationFlag::MergeInterpretBlocks:
+        A64MergeInterpretBlocksPass(block, conf.callbacks);
+        break;
+    default:
+        ASSERT_FALSE("Invalid IR pass {}", static_cast<u32>(pass));
+    }
+}
+
+} // Anonymous namespace
+
+void A64Optimize(IR::Block& block, const A64::UserConfig& conf) {
+    if (conf.enable_optimizations) {
+        const auto& pass_order = conf.pass_order.empty() ? default_pass_order : conf.pass_order;
+        for (const OptimizationFlag pass : pass_order) {
+            if (conf.HasOptimization(pass)) {
+                RunPass(block, conf, pass);
+            }
+        }
+    }
+    if (conf.HasOptimization(OptimizationFlag::PrintIR)) {
+        fmt::print("{}\n", IR::DumpBlock(block));
+    }
+    if (conf.HasOptimization(OptimizationFlag::Verification)) {
+        VerificationPass(block);
+    }
+}
+
+} // namespace Dynarmic::Optimization
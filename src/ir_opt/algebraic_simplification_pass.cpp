@@ -0,0 +1,357 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <algorithm>
+
+#include "common/bit_util.h"
+#include "common/common_types.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/ir_emitter.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "frontend/ir/value.h"
+#include "ir_opt/ir_matcher.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+using Op = Dynarmic::IR::Opcode;
+using namespace IRMatcher;
+
+namespace {
+
+IR::Value Zero(bool is_32_bit) {
+    return is_32_bit ? IR::Value{u32(0)} : IR::Value{u64(0)};
+}
+
+// Folds based on the following:
+//
+// 1. x + 0 -> x
+// 2. x - 0 -> x
+// 3. x - x -> 0
+//
+template <Op add, Op sub>
+bool FoldAddSub(IR::Inst& inst) {
+    if (const auto match = Inst<add, CaptureValue, UImm<0>, UImm<0>>::Match(inst)) {
+        inst.ReplaceUsesWith(std::get<0>(*match));
+        return true;
+    }
+    if (const auto match = Inst<sub, CaptureValue, UImm<0>, UImm<1>>::Match(inst)) {
+        inst.ReplaceUsesWith(std::get<0>(*match));
+        return true;
+    }
+    if (const auto match = Inst<sub, CaptureInst, CaptureInst, UImm<1>>::Match(inst)) {
+        if (IsSameInst(*match)) {
+            inst.ReplaceUsesWith(Zero(sub == Op::Sub32));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HasIdenticalOperands(const IR::Inst& inst) {
+    const IR::Value lhs = inst.GetArg(0);
+    const IR::Value rhs = inst.GetArg(1);
+    return !lhs.IsImmediate() && !rhs.IsImmediate() &&
+           lhs.GetInstRecursive() == rhs.GetInstRecursive();
+}
+
+// Folds based on the following:
+//
+// 1. x & x -> x
+// 2. x | x -> x
+// 3. x ^ x -> 0
+//
+bool FoldSelfLogical(IR::Inst& inst, bool is_32_bit) {
+    if (!HasIdenticalOperands(inst)) {
+        return false;
+    }
+
+    switch (inst.GetOpcode()) {
+    case Op::Eor32:
+    case Op::Eor64:
+        inst.ReplaceUsesWith(Zero(is_32_bit));
+        return true;
+    default:
+        inst.ReplaceUsesWith(inst.GetArg(0));
+        return true;
+    }
+}
+
+// Folds shifts of shifts by immediates into a single shift:
+//
+// 1. (x << a) << b -> x << (a + b)
+// 2. (x >> a) >> b -> x >> (a + b)
+//
+// Shifting out every bit produces zero, apart from arithmetic shifts which saturate.
+template <Op op, typename... CarryIn>
+bool FoldShiftOfShift(IR::Inst& inst, u64 bitsize, bool is_arithmetic) {
+    using Pattern =
+        Inst<op, Inst<op, CaptureValue, CaptureUImm, CarryIn...>, CaptureUImm, CarryIn...>;
+
+    const auto match = Pattern::Match(inst);
+    if (!match) {
+        return false;
+    }
+
+    const auto [value, inner_amount, outer_amount] = *match;
+    const u64 amount = inner_amount + outer_amount;
+    if (amount >= bitsize && !is_arithmetic) {
+        inst.ReplaceUsesWith(Zero(bitsize == 32));
+        return true;
+    }
+
+    inst.SetArg(0, value);
+    inst.SetArg(1, IR::Value{static_cast<u8>(std::min(amount, bitsize - 1))});
+    return true;
+}
+
+// Folds x * 2^n -> x << n
+template <Op op>
+bool FoldMultiplyByPowerOfTwo(IR::Block& block, IR::Inst& inst) {
+    const auto match = Inst<op, CaptureValue, CaptureUImm>::Match(inst);
+    if (!match) {
+        return false;
+    }
+
+    const auto [value, multiplier] = *match;
+    if (multiplier <= 1 || Common::BitCount(multiplier) != 1) {
+        return false;
+    }
+
+    IR::IREmitter ir{block};
+    ir.SetInsertionPoint(&inst);
+    const auto shift = static_cast<u8>(Common::HighestSetBit(multiplier));
+    inst.ReplaceUsesWith(ir.LogicalShiftLeft(IR::U32U64{value}, ir.Imm8(shift)));
+    return true;
+}
+
+// Folds truncations of extensions back to the original value:
+//
+// 1. LeastSignificantWord(ExtendWordToLong(x)) -> x
+// 2. LeastSignificantHalf(ExtendHalfToWord(x)) -> x
+// 3. LeastSignificantByte(ExtendByteToWord(x)) -> x
+//
+template <Op truncate, Op zero_extend, Op sign_extend>
+bool FoldTruncateOfExtend(IR::Inst& inst) {
+    if (const auto match = Inst<truncate, Inst<zero_extend, CaptureValue>>::Match(inst)) {
+        inst.ReplaceUsesWith(std::get<0>(*match));
+        return true;
+    }
+    if (const auto match = Inst<truncate, Inst<sign_extend, CaptureValue>>::Match(inst)) {
+        inst.ReplaceUsesWith(std::get<0>(*match));
+        return true;
+    }
+    return false;
+}
+
+// Folds extensions of extensions, and extensions of truncations of values which are already
+// zero-extended:
+//
+// 1. ZeroExtendWordToLong(ZeroExtendXToWord(x)) -> ZeroExtendXToLong(x)
+// 2. SignExtendWordToLong(ZeroExtendXToWord(x)) -> ZeroExtendXToLong(x)
+// 3. SignExtendWordToLong(SignExtendXToWord(x)) -> SignExtendXToLong(x)
+// 4. ZeroExtendWordToLong(LeastSignificantWord(ZeroExtendXToLong(x))) -> ZeroExtendXToLong(x)
+//
+bool FoldExtendChain(IR::Block& block, IR::Inst& inst) {
+    const Op op = inst.GetOpcode();
+    if (op != Op::ZeroExtendWordToLong && op != Op::SignExtendWordToLong) {
+        return false;
+    }
+
+    const IR::Value operand = inst.GetArg(0);
+    if (operand.IsImmediate()) {
+        return false;
+    }
+    const IR::Inst* operand_inst = operand.GetInstRecursive();
+    const Op operand_op = operand_inst->GetOpcode();
+
+    IR::IREmitter ir{block};
+    ir.SetInsertionPoint(&inst);
+
+    switch (operand_op) {
+    case Op::ZeroExtendByteToWord:
+    case Op::ZeroExtendHalfToWord:
+        inst.ReplaceUsesWith(ir.ZeroExtendToLong(IR::UAny{operand_inst->GetArg(0)}));
+        return true;
+    case Op::SignExtendByteToWord:
+    case Op::SignExtendHalfToWord:
+        if (op != Op::SignExtendWordToLong) {
+            return false;
+        }
+        inst.ReplaceUsesWith(ir.SignExtendToLong(IR::UAny{operand_inst->GetArg(0)}));
+        return true;
+    case Op::LeastSignificantWord: {
+        if (op != Op::ZeroExtendWordToLong) {
+            return false;
+        }
+        const IR::Value source = operand_inst->GetArg(0);
+        if (source.IsImmediate()) {
+            return false;
+        }
+        switch (source.GetInstRecursive()->GetOpcode()) {
+        case Op::ZeroExtendByteToLong:
+        case Op::ZeroExtendHalfToLong:
+        case Op::ZeroExtendWordToLong:
+            inst.ReplaceUsesWith(source);
+            return true;
+        default:
+            return false;
+        }
+    }
+    default:
+        return false;
+    }
+}
+
+// Folds vector operations on identical operands:
+//
+// 1. x & x -> x
+// 2. x | x -> x
+// 3. x ^ x -> 0
+// 4. x - x -> 0
+// 5. x > x -> 0
+//
+bool FoldVectorSelf(IR::Block& block, IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case Op::VectorAnd:
+    case Op::VectorOr:
+    case Op::VectorEor:
+    case Op::VectorSub8:
+    case Op::VectorSub16:
+    case Op::VectorSub32:
+    case Op::VectorSub64:
+    case Op::VectorGreaterS8:
+    case Op::VectorGreaterS16:
+    case Op::VectorGreaterS32:
+    case Op::VectorGreaterS64:
+        break;
+    default:
+        return false;
+    }
+
+    if (!HasIdenticalOperands(inst)) {
+        return false;
+    }
+
+    if (inst.GetOpcode() == Op::VectorAnd || inst.GetOpcode() == Op::VectorOr) {
+        inst.ReplaceUsesWith(inst.GetArg(0));
+        return true;
+    }
+
+    IR::IREmitter ir{block};
+    ir.SetInsertionPoint(&inst);
+    inst.ReplaceUsesWith(ir.ZeroVector());
+    return true;
+}
+
+// Folds selects where both alternatives are the same value.
+bool FoldConditionalSelect(IR::Inst& inst) {
+    switch (inst.GetOpcode()) {
+    case Op::ConditionalSelect32:
+    case Op::ConditionalSelect64:
+    case Op::ConditionalSelectNZCV:
+        break;
+    default:
+        return false;
+    }
+
+    const IR::Value then_ = inst.GetArg(1);
+    const IR::Value else_ = inst.GetArg(2);
+    if (then_.IsImmediate() || else_.IsImmediate()) {
+        if (then_.IsImmediate() && else_.IsImmediate() &&
+            then_.GetImmediateAsU64() == else_.GetImmediateAsU64()) {
+            inst.ReplaceUsesWith(then_);
+            return true;
+        }
+        return false;
+    }
+    if (then_.GetInstRecursive() != else_.GetInstRecursive()) {
+        return false;
+    }
+    inst.ReplaceUsesWith(then_);
+    return true;
+}
+
+} // anonymous namespace
+
+void AlgebraicSimplification(IR::Block& block) {
+    for (auto& inst : block) {
+        if (inst.HasAssociatedPseudoOperation()) {
+            continue;
+        }
+
+        switch (inst.GetOpcode()) {
+        case Op::Add32:
+        case Op::Sub32:
+            FoldAddSub<Op::Add32, Op::Sub32>(inst);
+            break;
+        case Op::Add64:
+        case Op::Sub64:
+            FoldAddSub<Op::Add64, Op::Sub64>(inst);
+            break;
+        case Op::And32:
+        case Op::Or32:
+        case Op::Eor32:
+            FoldSelfLogical(inst, true);
+            break;
+        case Op::And64:
+        case Op::Or64:
+        case Op::Eor64:
+            FoldSelfLogical(inst, false);
+            break;
+        case Op::LogicalShiftLeft32:
+            FoldShiftOfShift<Op::LogicalShiftLeft32, AnyValue>(inst, 32, false);
+            break;
+        case Op::LogicalShiftLeft64:
+            FoldShiftOfShift<Op::LogicalShiftLeft64>(inst, 64, false);
+            break;
+        case Op::LogicalShiftRight32:
+            FoldShiftOfShift<Op::LogicalShiftRight32, AnyValue>(inst, 32, false);
+            break;
+        case Op::LogicalShiftRight64:
+            FoldShiftOfShift<Op::LogicalShiftRight64>(inst, 64, false);
+            break;
+        case Op::ArithmeticShiftRight32:
+            FoldShiftOfShift<Op::ArithmeticShiftRight32, AnyValue>(inst, 32, true);
+            break;
+        case Op::ArithmeticShiftRight64:
+            FoldShiftOfShift<Op::ArithmeticShiftRight64>(inst, 64, true);
+            break;
+        case Op::Mul32:
+            FoldMultiplyByPowerOfTwo<Op::Mul32>(block, inst);
+            break;
+        case Op::Mul64:
+            FoldMultiplyByPowerOfTwo<Op::Mul64>(block, inst);
+            break;
+        case Op::LeastSignificantWord:
+            FoldTruncateOfExtend<Op::LeastSignificantWord, Op::ZeroExtendWordToLong,
+                                 Op::SignExtendWordToLong>(inst);
+            break;
+        case Op::LeastSignificantHalf:
+            FoldTruncateOfExtend<Op::LeastSignificantHalf, Op::ZeroExtendHalfToWord,
+                                 Op::SignExtendHalfToWord>(inst);
+            break;
+        case Op::LeastSignificantByte:
+            FoldTruncateOfExtend<Op::LeastSignificantByte, Op::ZeroExtendByteToWord,
+                                 Op::SignExtendByteToWord>(inst);
+            break;
+        case Op::ZeroExtendWordToLong:
+        case Op::SignExtendWordToLong:
+            FoldExtendChain(block, inst);
+            break;
+        case Op::ConditionalSelect32:
+        case Op::ConditionalSelect64:
+        case Op::ConditionalSelectNZCV:
+            FoldConditionalSelect(inst);
+            break;
+        default:
+            FoldVectorSelf(block, inst);
+            break;
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
@@ -0,0 +1,133 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <array>
+#include <optional>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "frontend/ir/value.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+/// Two instructions with equal keys compute the same value.
+struct ValueNumberKey {
+    IR::Opcode opcode;
+    std::array<IR::Type, IR::max_arg_count> arg_types{};
+    std::array<u64, IR::max_arg_count> arg_bits{};
+
+    bool operator==(const ValueNumberKey& other) const {
+        return opcode == other.opcode && arg_types == other.arg_types &&
+               arg_bits == other.arg_bits;
+    }
+};
+
+struct ValueNumberKeyHash {
+    size_t operator()(const ValueNumberKey& key) const {
+        u64 hash = static_cast<u64>(key.opcode);
+        for (size_t i = 0; i < IR::max_arg_count; i++) {
+            hash = (hash ^ static_cast<u64>(key.arg_types[i])) * 0x100000001B3ULL;
+            hash = (hash ^ key.arg_bits[i]) * 0x100000001B3ULL;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+bool IsArchitectureSpecific(IR::Opcode opcode) {
+    switch (opcode) {
+#define OPCODE(...)
+#define A32OPC(name, ...) case IR::Opcode::A32##name:
+#define A64OPC(name, ...) case IR::Opcode::A64##name:
+#include "frontend/ir/opcodes.inc"
+#undef OPCODE
+#undef A32OPC
+#undef A64OPC
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Is the result of inst determined only by its opcode and arguments?
+bool IsPure(const IR::Inst& inst) {
+    // Architecture specific instructions all access guest or host state.
+    if (IsArchitectureSpecific(inst.GetOpcode())) {
+        return false;
+    }
+
+    switch (inst.GetType()) {
+    case IR::Type::Void:
+    case IR::Type::Opaque:
+    case IR::Type::Table:
+        return false;
+    default:
+        break;
+    }
+
+    return !inst.MayHaveSideEffects() && !inst.IsMemoryRead() && !inst.ReadsFromCPSR() &&
+           !inst.ReadsFromCoreRegister() && !inst.ReadsFromFPCR() && !inst.ReadsFromFPSR() &&
+           !inst.IsAPseudoOperation() && !inst.HasAssociatedPseudoOperation();
+}
+
+std::optional<ValueNumberKey> MakeKey(const IR::Inst& inst) {
+    ValueNumberKey key{inst.GetOpcode()};
+
+    for (size_t i = 0; i < inst.NumArgs(); i++) {
+        const IR::Value arg = inst.GetArg(i);
+        if (!arg.IsImmediate()) {
+            key.arg_types[i] = IR::Type::Opaque;
+            key.arg_bits[i] = reinterpret_cast<u64>(arg.GetInstRecursive());
+            continue;
+        }
+
+        key.arg_types[i] = arg.GetType();
+        switch (arg.GetType()) {
+        case IR::Type::U1:
+        case IR::Type::U8:
+        case IR::Type::U16:
+        case IR::Type::U32:
+        case IR::Type::U64:
+            key.arg_bits[i] = arg.GetImmediateAsU64();
+            break;
+        case IR::Type::Cond:
+            key.arg_bits[i] = static_cast<u64>(arg.GetCond());
+            break;
+        default:
+            return std::nullopt;
+        }
+    }
+
+    return key;
+}
+
+} // anonymous namespace
+
+void CommonSubexpressionElimination(IR::Block& block) {
+    std::unordered_map<ValueNumberKey, IR::Inst*, ValueNumberKeyHash> value_numbers;
+
+    for (auto& inst : block) {
+        if (!IsPure(inst)) {
+            continue;
+        }
+
+        const auto key = MakeKey(inst);
+        if (!key) {
+            continue;
+        }
+
+        const auto [iter, inserted] = value_numbers.emplace(*key, &inst);
+        if (!inserted) {
+            inst.ReplaceUsesWith(IR::Value{iter->second});
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
@@ -3,6 +3,8 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <array>
+#include <cstring>
 #include <optional>
 
 #include "common/assert.h"
@@ -366,6 +368,123 @@ void FoldZeroExtendXToLong(IR::Inst& inst) {
     const u64 value = inst.GetArg(0).GetImmediateAsU64();
     inst.ReplaceUsesWith(IR::Value{value});
 }
+
+using Vector = std::array<u64, 2>;
+
+// Vector constants are represented as ZeroVector, ZeroExtendLongToQuad, VectorBroadcast or
+// Pack2x64To1x128 instructions with immediate arguments.
+std::optional<Vector> GetVectorConstant(IR::Value value) {
+    if (value.IsImmediate()) {
+        return std::nullopt;
+    }
+
+    const IR::Inst* inst = value.GetInstRecursive();
+    if (inst->GetOpcode() == Op::ZeroVector) {
+        return Vector{0, 0};
+    }
+    if (!inst->AreAllArgsImmediates()) {
+        return std::nullopt;
+    }
+
+    switch (inst->GetOpcode()) {
+    case Op::ZeroExtendLongToQuad:
+        return Vector{inst->GetArg(0).GetU64(), 0};
+    case Op::Pack2x64To1x128:
+        return Vector{inst->GetArg(0).GetU64(), inst->GetArg(1).GetU64()};
+    case Op::VectorBroadcast8:
+        return Vector{Common::Replicate<u64>(inst->GetArg(0).GetU8(), 8),
+                      Common::Replicate<u64>(inst->GetArg(0).GetU8(), 8)};
+    case Op::VectorBroadcast16:
+        return Vector{Common::Replicate<u64>(inst->GetArg(0).GetU16(), 16),
+                      Common::Replicate<u64>(inst->GetArg(0).GetU16(), 16)};
+    case Op::VectorBroadcast32:
+        return Vector{Common::Replicate<u64>(inst->GetArg(0).GetU32(), 32),
+                      Common::Replicate<u64>(inst->GetArg(0).GetU32(), 32)};
+    case Op::VectorBroadcast64:
+        return Vector{inst->GetArg(0).GetU64(), inst->GetArg(0).GetU64()};
+    default:
+        return std::nullopt;
+    }
+}
+
+void ReplaceUsesWithVector(IR::Block& block, IR::Inst& inst, const Vector& value) {
+    IR::IREmitter ir{block};
+    ir.SetInsertionPoint(&inst);
+
+    if (value[0] == 0 && value[1] == 0) {
+        inst.ReplaceUsesWith(ir.ZeroVector());
+    } else {
+        inst.ReplaceUsesWith(ir.Pack2x64To1x128(ir.Imm64(value[0]), ir.Imm64(value[1])));
+    }
+}
+
+template <typename T, typename Fn>
+Vector Lanewise(const Vector& lhs, const Vector& rhs, Fn fn) {
+    std::array<T, sizeof(Vector) / sizeof(T)> a;
+    std::array<T, sizeof(Vector) / sizeof(T)> b;
+    std::memcpy(a.data(), lhs.data(), sizeof(Vector));
+    std::memcpy(b.data(), rhs.data(), sizeof(Vector));
+
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = static_cast<T>(fn(a[i], b[i]));
+    }
+
+    Vector result;
+    std::memcpy(result.data(), a.data(), sizeof(Vector));
+    return result;
+}
+
+template <typename Fn>
+void FoldVectorBinary(IR::Block& block, IR::Inst& inst, Fn fn) {
+    const auto lhs = GetVectorConstant(inst.GetArg(0));
+    const auto rhs = GetVectorConstant(inst.GetArg(1));
+    if (!lhs || !rhs) {
+        return;
+    }
+
+    ReplaceUsesWithVector(block, inst, fn(*lhs, *rhs));
+}
+
+template <typename T>
+void FoldVectorAdd(IR::Block& block, IR::Inst& inst) {
+    FoldVectorBinary(block, inst, [](const Vector& lhs, const Vector& rhs) {
+        return Lanewise<T>(lhs, rhs, [](T a, T b) { return a + b; });
+    });
+}
+
+template <typename T>
+void FoldVectorSub(IR::Block& block, IR::Inst& inst) {
+    FoldVectorBinary(block, inst, [](const Vector& lhs, const Vector& rhs) {
+        return Lanewise<T>(lhs, rhs, [](T a, T b) { return a - b; });
+    });
+}
+
+template <typename T>
+void FoldVectorGetElement(IR::Inst& inst) {
+    const auto vector = GetVectorConstant(inst.GetArg(0));
+    if (!vector || !inst.GetArg(1).IsImmediate()) {
+        return;
+    }
+
+    std::array<T, sizeof(Vector) / sizeof(T)> elements;
+    std::memcpy(elements.data(), vector->data(), sizeof(Vector));
+
+    const size_t index = inst.GetArg(1).GetU8();
+    ASSERT(index < elements.size());
+    inst.ReplaceUsesWith(IR::Value{elements[index]});
+}
+
+void FoldVectorNot(IR::Block& block, IR::Inst& inst) {
+    if (const auto vector = GetVectorConstant(inst.GetArg(0))) {
+        ReplaceUsesWithVector(block, inst, Vector{~(*vector)[0], ~(*vector)[1]});
+    }
+}
+
+void FoldVectorZeroUpper(IR::Block& block, IR::Inst& inst) {
+    if (const auto vector = GetVectorConstant(inst.GetArg(0))) {
+        ReplaceUsesWithVector(block, inst, Vector{(*vector)[0], 0});
+    }
+}
 } // Anonymous namespace
 
 void ConstantPropagation(IR::Block& block) {
@@ -565,6 +684,63 @@ void ConstantPropagation(IR::Block& block) {
         case Op::ByteReverseDual:
             FoldByteReverse(inst, opcode);
             break;
+        case Op::VectorGetElement8:
+            FoldVectorGetElement<u8>(inst);
+            break;
+        case Op::VectorGetElement16:
+            FoldVectorGetElement<u16>(inst);
+            break;
+        case Op::VectorGetElement32:
+            FoldVectorGetElement<u32>(inst);
+            break;
+        case Op::VectorGetElement64:
+            FoldVectorGetElement<u64>(inst);
+            break;
+        case Op::VectorAnd:
+            FoldVectorBinary(block, inst, [](const Vector& a, const Vector& b) {
+                return Vector{a[0] & b[0], a[1] & b[1]};
+            });
+            break;
+        case Op::VectorOr:
+            FoldVectorBinary(block, inst, [](const Vector& a, const Vector& b) {
+                return Vector{a[0] | b[0], a[1] | b[1]};
+            });
+            break;
+        case Op::VectorEor:
+            FoldVectorBinary(block, inst, [](const Vector& a, const Vector& b) {
+                return Vector{a[0] ^ b[0], a[1] ^ b[1]};
+            });
+            break;
+        case Op::VectorNot:
+            FoldVectorNot(block, inst);
+            break;
+        case Op::VectorAdd8:
+            FoldVectorAdd<u8>(block, inst);
+            break;
+        case Op::VectorAdd16:
+            FoldVectorAdd<u16>(block, inst);
+            break;
+        case Op::VectorAdd32:
+            FoldVectorAdd<u32>(block, inst);
+            break;
+        case Op::VectorAdd64:
+            FoldVectorAdd<u64>(block, inst);
+            break;
+        case Op::VectorSub8:
+            FoldVectorSub<u8>(block, inst);
+            break;
+        case Op::VectorSub16:
+            FoldVectorSub<u16>(block, inst);
+            break;
+        case Op::VectorSub32:
+            FoldVectorSub<u32>(block, inst);
+            break;
+        case Op::VectorSub64:
+            FoldVectorSub<u64>(block, inst);
+            break;
+        case Op::VectorZeroUpper:
+            FoldVectorZeroUpper(block, inst);
+            break;
         default:
             break;
         }
@@ -0,0 +1,189 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include "common/common_types.h"
+#include "common/fp/fpcr.h"
+#include "common/fp/fpsr.h"
+#include "common/fp/info.h"
+#include "common/fp/op.h"
+#include "common/fp/op/FPNeg.h"
+#include "common/fp/rounding_mode.h"
+#include "common/fp/util.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+using Op = Dynarmic::IR::Opcode;
+
+namespace {
+
+template <typename FPT>
+constexpr FPT One() {
+    return static_cast<FPT>(static_cast<FPT>(FP::FPInfo<FPT>::exponent_bias)
+                            << FP::FPInfo<FPT>::explicit_mantissa_width);
+}
+
+template <typename FPT>
+FPT GetOperand(const IR::Inst& inst, size_t index) {
+    return static_cast<FPT>(inst.GetArg(index).GetImmediateAsU64());
+}
+
+template <typename FPT>
+bool HasNaNOperand(const IR::Inst& inst, size_t num_operands) {
+    for (size_t i = 0; i < num_operands; i++) {
+        if (FP::IsNaN(GetOperand<FPT>(inst, i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Results are only folded when no floating-point exception would be raised, as the cumulative
+// exception bits of the FPSR would otherwise go unset. NaN propagation is left to the backend.
+template <typename FPT, typename Fn>
+void FoldArithmetic(IR::Inst& inst, size_t num_operands, Fn fn) {
+    if (!inst.AreAllArgsImmediates() || HasNaNOperand<FPT>(inst, num_operands)) {
+        return;
+    }
+
+    FP::FPSR fpsr;
+    const auto result = fn(fpsr);
+    if (fpsr.Value() != 0) {
+        return;
+    }
+
+    inst.ReplaceUsesWith(IR::Value{result});
+}
+
+// Addition, subtraction and multiplication are evaluated as fused multiply-adds, whose single
+// rounding gives the same result as the unfused operation when one operand of the product is one
+// or the addend is zero.
+template <typename FPT>
+void FoldAdd(IR::Inst& inst, FP::FPCR fpcr, bool is_sub) {
+    FoldArithmetic<FPT>(inst, 2, [&](FP::FPSR& fpsr) {
+        const FPT lhs = GetOperand<FPT>(inst, 0);
+        const FPT rhs = GetOperand<FPT>(inst, 1);
+        return FP::FPMulAdd<FPT>(lhs, is_sub ? FP::FPNeg(rhs) : rhs, One<FPT>(), fpcr, fpsr);
+    });
+}
+
+template <typename FPT>
+void FoldMul(IR::Inst& inst, FP::FPCR fpcr) {
+    if (!inst.AreAllArgsImmediates()) {
+        return;
+    }
+
+    // The sign of a zero product depends on the addend, so zero products are left alone.
+    if (FP::IsZero(GetOperand<FPT>(inst, 0), fpcr) || FP::IsZero(GetOperand<FPT>(inst, 1), fpcr)) {
+        return;
+    }
+
+    FoldArithmetic<FPT>(inst, 2, [&](FP::FPSR& fpsr) {
+        const FPT lhs = GetOperand<FPT>(inst, 0);
+        const FPT rhs = GetOperand<FPT>(inst, 1);
+        return FP::FPMulAdd<FPT>(FP::FPInfo<FPT>::Zero(false), lhs, rhs, fpcr, fpsr);
+    });
+}
+
+template <typename FPT>
+void FoldMulAdd(IR::Inst& inst, FP::FPCR fpcr) {
+    FoldArithmetic<FPT>(inst, 3, [&](FP::FPSR& fpsr) {
+        return FP::FPMulAdd<FPT>(GetOperand<FPT>(inst, 0), GetOperand<FPT>(inst, 1),
+                                 GetOperand<FPT>(inst, 2), fpcr, fpsr);
+    });
+}
+
+template <typename FPT_TO, typename FPT_FROM>
+void FoldConvert(IR::Inst& inst, FP::FPCR fpcr) {
+    FoldArithmetic<FPT_FROM>(inst, 1, [&](FP::FPSR& fpsr) {
+        const auto rounding_mode = static_cast<FP::RoundingMode>(inst.GetArg(1).GetU8());
+        return FP::FPConvert<FPT_TO, FPT_FROM>(GetOperand<FPT_FROM>(inst, 0), fpcr, rounding_mode,
+                                               fpsr);
+    });
+}
+
+// Negation and absolute value only manipulate the sign bit and never raise exceptions.
+template <typename FPT>
+void FoldSign(IR::Inst& inst, bool is_abs) {
+    if (!inst.AreAllArgsImmediates()) {
+        return;
+    }
+
+    const FPT operand = GetOperand<FPT>(inst, 0);
+    const FPT result = is_abs ? static_cast<FPT>(operand & ~FP::FPInfo<FPT>::sign_mask)
+                              : FP::FPNeg(operand);
+    inst.ReplaceUsesWith(IR::Value{result});
+}
+
+} // anonymous namespace
+
+void FPConstantFolding(IR::Block& block, FP::FPCR fpcr) {
+    for (auto& inst : block) {
+        switch (inst.GetOpcode()) {
+        case Op::A32SetFpscr:
+        case Op::A64SetFPCR:
+            // Later instructions execute under a different FPCR.
+            return;
+        case Op::FPAbs16:
+            FoldSign<u16>(inst, true);
+            break;
+        case Op::FPAbs32:
+            FoldSign<u32>(inst, true);
+            break;
+        case Op::FPAbs64:
+            FoldSign<u64>(inst, true);
+            break;
+        case Op::FPNeg16:
+            FoldSign<u16>(inst, false);
+            break;
+        case Op::FPNeg32:
+            FoldSign<u32>(inst, false);
+            break;
+        case Op::FPNeg64:
+            FoldSign<u64>(inst, false);
+            break;
+        case Op::FPAdd32:
+            FoldAdd<u32>(inst, fpcr, false);
+            break;
+        case Op::FPAdd64:
+            FoldAdd<u64>(inst, fpcr, false);
+            break;
+        case Op::FPSub32:
+            FoldAdd<u32>(inst, fpcr, true);
+            break;
+        case Op::FPSub64:
+            FoldAdd<u64>(inst, fpcr, true);
+            break;
+        case Op::FPMul32:
+            FoldMul<u32>(inst, fpcr);
+            break;
+        case Op::FPMul64:
+            FoldMul<u64>(inst, fpcr);
+            break;
+        case Op::FPMulAdd16:
+            FoldMulAdd<u16>(inst, fpcr);
+            break;
+        case Op::FPMulAdd32:
+            FoldMulAdd<u32>(inst, fpcr);
+            break;
+        case Op::FPMulAdd64:
+            FoldMulAdd<u64>(inst, fpcr);
+            break;
+        case Op::FPSingleToDouble:
+            FoldConvert<u64, u32>(inst, fpcr);
+            break;
+        case Op::FPDoubleToSingle:
+            FoldConvert<u32, u64>(inst, fpcr);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
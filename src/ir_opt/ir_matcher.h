@@ -42,6 +42,8 @@ struct CaptureUImm {
     using ReturnType = std::tuple<u64>;
 
     static std::optional<ReturnType> Match(IR::Value value) {
+        if (!value.IsImmediate())
+            return std::nullopt;
         return std::tuple(value.GetImmediateAsU64());
     }
 };
@@ -50,16 +52,26 @@ struct CaptureSImm {
     using ReturnType = std::tuple<s64>;
 
     static std::optional<ReturnType> Match(IR::Value value) {
+        if (!value.IsImmediate())
+            return std::nullopt;
         return std::tuple(value.GetImmediateAsS64());
     }
 };
 
+struct AnyValue {
+    using ReturnType = std::tuple<>;
+
+    static std::optional<ReturnType> Match(IR::Value) {
+        return std::tuple();
+    }
+};
+
 template <u64 Value>
 struct UImm {
     using ReturnType = std::tuple<>;
 
     static std::optional<std::tuple<>> Match(IR::Value value) {
-        if (value.GetImmediateAsU64() == Value)
+        if (value.IsImmediate() && value.GetImmediateAsU64() == Value)
             return std::tuple();
         return std::nullopt;
     }
@@ -70,7 +82,7 @@ struct SImm {
     using ReturnType = std::tuple<>;
 
     static std::optional<std::tuple<>> Match(IR::Value value) {
-        if (value.GetImmediateAsS64() == Value)
+        if (value.IsImmediate() && value.GetImmediateAsS64() == Value)
             return std::tuple();
         return std::nullopt;
     }
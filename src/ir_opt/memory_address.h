@@ -0,0 +1,106 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#pragma once
+
+#include "common/common_types.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "frontend/ir/value.h"
+
+namespace Dynarmic::Optimization {
+
+/// A guest address expressed as base + offset. A null base denotes an absolute address.
+struct Address {
+    IR::Inst* base;
+    u64 offset;
+    u64 mask;
+};
+
+/// Decomposes an address into a base and a constant offset by looking through additions and
+/// subtractions of immediates.
+inline Address DecomposeAddress(IR::Value value) {
+    const u64 mask = value.GetType() == IR::Type::U32 ? 0xFFFFFFFF : 0xFFFFFFFFFFFFFFFF;
+    u64 offset = 0;
+
+    while (!value.IsImmediate()) {
+        IR::Inst* inst = value.GetInstRecursive();
+        if (inst->HasAssociatedPseudoOperation()) {
+            return {inst, offset & mask, mask};
+        }
+
+        switch (inst->GetOpcode()) {
+        case IR::Opcode::Add32:
+        case IR::Opcode::Add64:
+            if (!inst->GetArg(2).IsZero()) {
+                return {inst, offset & mask, mask};
+            }
+            if (inst->GetArg(1).IsImmediate()) {
+                offset += inst->GetArg(1).GetImmediateAsU64();
+                value = inst->GetArg(0);
+                continue;
+            }
+            if (inst->GetArg(0).IsImmediate()) {
+                offset += inst->GetArg(0).GetImmediateAsU64();
+                value = inst->GetArg(1);
+                continue;
+            }
+            return {inst, offset & mask, mask};
+        case IR::Opcode::Sub32:
+        case IR::Opcode::Sub64:
+            if (!inst->GetArg(2).IsUnsignedImmediate(1) || !inst->GetArg(1).IsImmediate()) {
+                return {inst, offset & mask, mask};
+            }
+            offset -= inst->GetArg(1).GetImmediateAsU64();
+            value = inst->GetArg(0);
+            continue;
+        default:
+            return {inst, offset & mask, mask};
+        }
+    }
+
+    return {nullptr, (offset + value.GetImmediateAsU64()) & mask, mask};
+}
+
+/// Returns true if `b` is known to be exactly `distance` bytes after `a`.
+inline bool IsAddressAfter(const Address& a, const Address& b, u64 distance) {
+    return a.base == b.base && a.mask == b.mask && ((a.offset + distance) & a.mask) == b.offset;
+}
+
+/// Register writes have side effects, but none which observe the order of memory accesses.
+inline bool IsRegisterWrite(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::A32SetRegister:
+    case IR::Opcode::A32SetExtendedRegister32:
+    case IR::Opcode::A32SetExtendedRegister64:
+    case IR::Opcode::A32SetVector:
+    case IR::Opcode::A64SetW:
+    case IR::Opcode::A64SetX:
+    case IR::Opcode::A64SetS:
+    case IR::Opcode::A64SetD:
+    case IR::Opcode::A64SetQ:
+    case IR::Opcode::A64SetSP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Finds the next memory access after `iter`, provided that no instruction in between would
+/// observe the two accesses being reordered.
+inline IR::Inst* FindNextMemoryAccess(IR::Block::iterator iter, IR::Block::iterator end) {
+    for (++iter; iter != end; ++iter) {
+        if (iter->IsMemoryReadOrWrite()) {
+            return &*iter;
+        }
+        if (iter->MayHaveSideEffects() && !IsRegisterWrite(iter->GetOpcode())) {
+            return nullptr;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace Dynarmic::Optimization
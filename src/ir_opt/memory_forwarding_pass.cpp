@@ -0,0 +1,120 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "common/common_types.h"
+#include "frontend/ir/basic_block.h"
+#include "frontend/ir/microinstruction.h"
+#include "frontend/ir/opcodes.h"
+#include "frontend/ir/value.h"
+#include "ir_opt/memory_address.h"
+#include "ir_opt/passes.h"
+
+namespace Dynarmic::Optimization {
+
+namespace {
+
+struct KnownValue {
+    Address address;
+    size_t size;
+    IR::Value value;
+};
+
+std::optional<size_t> AccessSize(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::A32ReadMemory8:
+    case IR::Opcode::A32WriteMemory8:
+    case IR::Opcode::A64ReadMemory8:
+    case IR::Opcode::A64WriteMemory8:
+        return 1;
+    case IR::Opcode::A32ReadMemory16:
+    case IR::Opcode::A32WriteMemory16:
+    case IR::Opcode::A64ReadMemory16:
+    case IR::Opcode::A64WriteMemory16:
+        return 2;
+    case IR::Opcode::A32ReadMemory32:
+    case IR::Opcode::A32WriteMemory32:
+    case IR::Opcode::A64ReadMemory32:
+    case IR::Opcode::A64WriteMemory32:
+        return 4;
+    case IR::Opcode::A32ReadMemory64:
+    case IR::Opcode::A32WriteMemory64:
+    case IR::Opcode::A64ReadMemory64:
+    case IR::Opcode::A64WriteMemory64:
+        return 8;
+    case IR::Opcode::A64ReadMemory128:
+    case IR::Opcode::A64WriteMemory128:
+        return 16;
+    default:
+        return std::nullopt;
+    }
+}
+
+bool MayOverlap(const Address& a, size_t a_size, const Address& b, size_t b_size) {
+    if (a.base != b.base || a.mask != b.mask) {
+        return true;
+    }
+    return ((b.offset - a.offset) & a.mask) < a_size || ((a.offset - b.offset) & a.mask) < b_size;
+}
+
+bool IsSameLocation(const Address& a, const Address& b) {
+    return a.base == b.base && a.offset == b.offset && a.mask == b.mask;
+}
+
+/// Instructions which may cause guest memory to change in ways we cannot track.
+bool InvalidatesKnownValues(const IR::Inst& inst) {
+    return inst.IsBarrier() || inst.AltersExclusiveState() || inst.IsAtomicMemoryOperation() ||
+           inst.CausesCPUException() || inst.IsCoprocessorInstruction() ||
+           inst.GetOpcode() == IR::Opcode::A64DataCacheOperationRaised;
+}
+
+} // anonymous namespace
+
+void MemoryForwarding(IR::Block& block) {
+    std::vector<KnownValue> known_values;
+
+    for (auto& inst : block) {
+        if (InvalidatesKnownValues(inst)) {
+            known_values.clear();
+            continue;
+        }
+
+        const auto size = AccessSize(inst.GetOpcode());
+        if (!size) {
+            if (inst.IsSharedMemoryWrite()) {
+                known_values.clear();
+            }
+            continue;
+        }
+
+        const Address address = DecomposeAddress(inst.GetArg(0));
+
+        if (inst.IsSharedMemoryWrite()) {
+            known_values.erase(std::remove_if(known_values.begin(), known_values.end(),
+                                              [&](const KnownValue& known) {
+                                                  return MayOverlap(known.address, known.size,
+                                                                    address, *size);
+                                              }),
+                               known_values.end());
+            known_values.push_back({address, *size, inst.GetArg(1)});
+            continue;
+        }
+
+        const auto iter =
+            std::find_if(known_values.begin(), known_values.end(), [&](const KnownValue& known) {
+                return known.size == *size && IsSameLocation(known.address, address);
+            });
+        if (iter != known_values.end()) {
+            inst.ReplaceUsesWith(iter->value);
+        } else {
+            known_values.push_back({address, *size, IR::Value{&inst}});
+        }
+    }
+}
+
+} // namespace Dynarmic::Optimization
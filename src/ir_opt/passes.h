@@ -7,13 +7,18 @@
 
 namespace Dynarmic::A32 {
 struct UserCallbacks;
-}
+struct UserConfig;
+} // namespace Dynarmic::A32
 
 namespace Dynarmic::A64 {
 struct UserCallbacks;
 struct UserConfig;
 } // namespace Dynarmic::A64
 
+namespace Dynarmic::FP {
+class FPCR;
+}
+
 namespace Dynarmic::IR {
 class Block;
 }
@@ -21,14 +26,28 @@ class Block;
 namespace Dynarmic::Optimization {
 
 void A32ConstantMemoryReads(IR::Block& block, A32::UserCallbacks* cb);
+void A32DeadFlagElimination(IR::Block& block, const A32::UserConfig& conf);
 void A32GetSetElimination(IR::Block& block);
+void A32MemoryCoalescing(IR::Block& block, const A32::UserConfig& conf);
 void A32MergeInterpretBlocksPass(IR::Block& block, A32::UserCallbacks* cb);
 void A64CallbackConfigPass(IR::Block& block, const A64::UserConfig& conf);
+void A64ConstantMemoryReads(IR::Block& block, A64::UserCallbacks* cb);
+void A64DeadFlagElimination(IR::Block& block, const A64::UserConfig& conf);
 void A64GetSetElimination(IR::Block& block);
+void A64MemoryCoalescing(IR::Block& block, const A64::UserConfig& conf);
 void A64MergeInterpretBlocksPass(IR::Block& block, A64::UserCallbacks* cb);
+void A64PageLookupSharing(IR::Block& block, const A64::UserConfig& conf);
+void AlgebraicSimplification(IR::Block& block);
+void CommonSubexpressionElimination(IR::Block& block);
 void ConstantPropagation(IR::Block& block);
 void DeadCodeElimination(IR::Block& block);
+void FPConstantFolding(IR::Block& block, FP::FPCR fpcr);
 void IdentityRemovalPass(IR::Block& block);
+void MemoryForwarding(IR::Block& block);
 void VerificationPass(const IR::Block& block);
 
+/// Runs the IR passes selected by conf on a block, then any requested debugging passes.
+void A32Optimize(IR::Block& block, const A32::UserConfig& conf);
+void A64Optimize(IR::Block& block, const A64::UserConfig& conf);
+
 } // namespace Dynarmic::Optimization
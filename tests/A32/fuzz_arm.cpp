@@ -192,6 +192,7 @@ Dynarmic::A32::UserConfig GetUserConfig(ArmTestEnv& testenv) {
     user_config.enable_fast_dispatch = false;
     user_config.callbacks = &testenv;
     user_config.always_little_endian = true;
+    user_config.optimizations |= Dynarmic::OptimizationFlag::Verification;
     return user_config;
 }
 
@@ -3,6 +3,11 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <catch.hpp>
 #include <dynarmic/A32/a32.h>
 
@@ -529,3 +534,283 @@ TEST_CASE("arm: Cleared Q flag 2", "[arm][A32][JitA64]") {
 
     REQUIRE((jit.Cpsr() & (1 << 27)) == 0);
 }
+
+TEST_CASE("arm: Cross-block flag elimination", "[arm][A32]") {
+    ArmTestEnv test_env;
+    A32::UserConfig config = GetUserConfig(&test_env);
+    config.optimizations |= OptimizationFlag::CrossBlockFlagElimination;
+    A32::Jit jit{config};
+
+    test_env.code_mem = {
+        0xe2500001, // subs r0, r0, #1
+        0xeaffffff, // b +#0
+        0xe1510002, // cmp r1, r2
+        0x03a03001, // moveq r3, #1
+        0xeafffffe, // b +#0
+    };
+
+    jit.Regs()[0] = 0;
+    jit.Regs()[1] = 42;
+    jit.Regs()[2] = 42;
+    jit.Regs()[15] = 0;
+    jit.SetCpsr(0x000001d0); // User-mode
+
+    // The successor overwrites NZCV, so the first block does not update it.
+    test_env.ticks_left = 2;
+    jit.Run();
+
+    REQUIRE(jit.Regs()[0] == 0xFFFFFFFF);
+    REQUIRE(jit.Regs()[15] == 8);
+    REQUIRE(jit.Cpsr() == 0x000001d0);
+
+    test_env.ticks_left = 10;
+    jit.Run();
+
+    REQUIRE(jit.Regs()[3] == 1);
+    REQUIRE(jit.Cpsr() == 0x600001d0);
+
+    // Invalidating the successor also invalidates the first block, which now must update NZCV.
+    test_env.code_mem[2] = 0x43a03001; // movmi r3, #1
+    test_env.code_mem[3] = 0xe320f000; // nop
+    jit.InvalidateCacheRange(8, 4);
+
+    jit.Regs()[0] = 0;
+    jit.Regs()[3] = 0;
+    jit.Regs()[15] = 0;
+    jit.SetCpsr(0x000001d0);
+
+    test_env.ticks_left = 4;
+    jit.Run();
+
+    REQUIRE(jit.Regs()[3] == 1);
+    REQUIRE(jit.Cpsr() == 0x800001d0);
+}
+
+TEST_CASE("arm: Software TLB", "[arm][A32]") {
+    ArmTestEnv test_env;
+    std::array<u32, 1024> page_a{};
+    std::array<u32, 1024> page_b{};
+    page_a[1] = 0x11223344;
+    page_b[1] = 0x44332211;
+    test_env.translated_pages[0x10000] = page_a.data();
+
+    A32::UserConfig config = GetUserConfig(&test_env);
+    config.enable_software_tlb = true;
+    A32::Jit jit{config};
+
+    test_env.code_mem = {
+        0xe5801000, // str r1, [r0]
+        0xe5902004, // ldr r2, [r0, #4]
+        0xe5943000, // ldr r3, [r4]
+        0xe5945004, // ldr r5, [r4, #4]
+        0xe5106002, // ldr r6, [r0, #-2]
+        0xeafffffe, // b +#0
+    };
+
+    jit.Regs()[0] = 0x10000;
+    jit.Regs()[1] = 0xcafebabe;
+    jit.Regs()[4] = 0x20000;
+    jit.SetCpsr(0x000001d0); // User-mode
+
+    test_env.ticks_left = 6;
+    jit.Run();
+
+    REQUIRE(page_a[0] == 0xcafebabe);
+    REQUIRE(jit.Regs()[2] == 0x11223344);
+    REQUIRE(jit.Regs()[3] == 0x03020100);
+    REQUIRE(jit.Regs()[5] == 0x07060504);
+    REQUIRE(jit.Regs()[6] == 0x0100fffe);
+    REQUIRE(test_env.modified_memory.empty());
+    // The page at 0x20000 does not translate, which is cached as well.
+    REQUIRE(test_env.translate_address_calls == 2);
+
+    // Remapped pages are picked up once the TLB is flushed.
+    test_env.translated_pages[0x10000] = page_b.data();
+    jit.FlushSoftwareTLB();
+
+    jit.Regs()[15] = 0;
+    test_env.ticks_left = 6;
+    jit.Run();
+
+    REQUIRE(page_b[0] == 0xcafebabe);
+    REQUIRE(jit.Regs()[2] == 0x44332211);
+    REQUIRE(test_env.translate_address_calls == 4);
+}
+
+TEST_CASE("arm: Flat memory", "[arm][A32]") {
+    ArmTestEnv test_env;
+    std::vector<u32> memory((0x10000 + 8) / sizeof(u32));
+    memory[0x1001] = 0x11223344;
+
+    A32::UserConfig config = GetUserConfig(&test_env);
+    config.flat_memory_base = reinterpret_cast<u8*>(memory.data());
+    config.flat_memory_mask = 0xFFFF;
+    A32::Jit jit{config};
+
+    test_env.code_mem = {
+        0xe5801000, // str r1, [r0]
+        0xe5902004, // ldr r2, [r0, #4]
+        0xe5943000, // ldr r3, [r4]
+        0xe8900060, // ldm r0, {r5, r6}
+        0xe5441001, // strb r1, [r4, #-1]
+        0xeafffffe, // b +#0
+    };
+
+    jit.Regs()[0] = 0x4000;
+    jit.Regs()[1] = 0xcafebabe;
+    jit.Regs()[4] = 0x7fff4004;
+    jit.SetCpsr(0x000001d0); // User-mode
+
+    test_env.ticks_left = 6;
+    jit.Run();
+
+    REQUIRE(memory[0x1000] == 0xbefebabe);
+    REQUIRE(jit.Regs()[2] == 0x11223344);
+    REQUIRE(jit.Regs()[3] == 0x11223344);
+    REQUIRE(jit.Regs()[5] == 0xcafebabe);
+    REQUIRE(jit.Regs()[6] == 0x11223344);
+    REQUIRE(test_env.modified_memory.empty());
+}
+
+TEST_CASE("arm: Memory accesses to unmapped pages call the memory callbacks", "[arm][A32]") {
+    ArmTestEnv test_env;
+    A32::UserConfig config = GetUserConfig(&test_env);
+    auto page_table = std::make_unique<std::array<u8*, A32::UserConfig::NUM_PAGE_TABLE_ENTRIES>>();
+    config.page_table = page_table.get();
+    A32::Jit jit{config};
+
+    test_env.code_mem = {
+        0xe5910000, // ldr r0, [r1]
+        0xe5820000, // str r0, [r2]
+        0xe5d13001, // ldrb r3, [r1, #1]
+        0xe1c230b4, // strh r3, [r2, #4]
+        0xeafffffe, // b +#0
+    };
+
+    jit.Regs()[1] = 0x10000;
+    jit.Regs()[2] = 0x20000;
+    jit.SetCpsr(0x000001d0); // User-mode
+
+    test_env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(jit.Regs()[0] == 0x03020100);
+    REQUIRE(jit.Regs()[3] == 0x01);
+    REQUIRE(test_env.MemoryRead32(0x20000) == 0x03020100);
+    REQUIRE(test_env.MemoryRead16(0x20004) == 0x0001);
+}
+
+TEST_CASE("arm: LDM and STM are coalesced into paired accesses", "[arm][A32]") {
+    ArmTestEnv test_env;
+    A32::UserConfig config = GetUserConfig(&test_env);
+    auto page_table = std::make_unique<std::array<u8*, A32::UserConfig::NUM_PAGE_TABLE_ENTRIES>>();
+    std::array<u8, 4096> page{};
+    for (size_t i = 0; i < page.size(); i++) {
+        // Differs from what the memory callbacks return for the same address.
+        page[i] = static_cast<u8>(~i);
+    }
+    (*page_table)[1] = page.data();
+
+    u32 block_address = 0x1200;
+    u32 expected_r12 = 0xfbfaf9f8;
+    u32 expected_lr = 0xfffefdfc;
+
+    SECTION("Callbacks") {}
+
+    SECTION("Page table") {
+        config.page_table = page_table.get();
+        expected_r12 = 0x04050607;
+        expected_lr = 0x00010203;
+    }
+
+    SECTION("Page table page crossing") {
+        config.page_table = page_table.get();
+        block_address = 0x1FFC;
+        expected_r12 = 0x08090a0b;
+        expected_lr = 0x04050607;
+    }
+
+    A32::Jit jit{config};
+
+    test_env.code_mem = {
+        0xe92d001e, // push {r1, r2, r3, r4}
+        0xe8bd01e0, // pop {r5, r6, r7, r8}
+        0xe880000e, // stm r0, {r1, r2, r3}
+        0xe8900e00, // ldm r0, {r9, r10, r11}
+        0xe9105000, // ldmdb r0, {r12, lr}
+        0xeafffffe, // b +#0
+    };
+
+    jit.Regs()[0] = block_address;
+    jit.Regs()[1] = 0x11111111;
+    jit.Regs()[2] = 0x22222222;
+    jit.Regs()[3] = 0x33333333;
+    jit.Regs()[4] = 0x44444444;
+    jit.Regs()[13] = 0x1100;
+    jit.SetCpsr(0x000001d0); // User-mode
+
+    test_env.ticks_left = 6;
+    jit.Run();
+
+    REQUIRE(jit.Regs()[5] == 0x11111111);
+    REQUIRE(jit.Regs()[6] == 0x22222222);
+    REQUIRE(jit.Regs()[7] == 0x33333333);
+    REQUIRE(jit.Regs()[8] == 0x44444444);
+    REQUIRE(jit.Regs()[9] == 0x11111111);
+    REQUIRE(jit.Regs()[10] == 0x22222222);
+    REQUIRE(jit.Regs()[11] == 0x33333333);
+    REQUIRE(jit.Regs()[12] == expected_r12);
+    REQUIRE(jit.Regs()[13] == 0x1100);
+    REQUIRE(jit.Regs()[14] == expected_lr);
+
+    if (config.page_table) {
+        REQUIRE(page[0x0F0] == 0x11);
+        REQUIRE(page[0x0FC] == 0x44);
+    } else {
+        REQUIRE(test_env.MemoryRead32(0x10F0) == 0x11111111);
+        REQUIRE(test_env.MemoryRead32(0x10FC) == 0x44444444);
+    }
+    if (block_address == 0x1FFC) {
+        // Pairs which would cross into another page are performed through callbacks.
+        REQUIRE(page[0xFFC] == 0x03);
+        REQUIRE(test_env.MemoryRead32(0x1FFC) == 0x11111111);
+        REQUIRE(test_env.MemoryRead32(0x2000) == 0x22222222);
+        REQUIRE(test_env.MemoryRead32(0x2004) == 0x33333333);
+    }
+}
+
+TEST_CASE("arm: Consecutive interpreted instructions are merged", "[arm][A32]") {
+    ArmTestEnv test_env;
+    A32::Jit jit{GetUserConfig(&test_env)};
+
+    test_env.code_mem = {
+        0xe8c00002, // stm r0, {r1}^
+        0xe8d00004, // ldm r0, {r2}^
+        0xf1080080, // cpsie i
+        0xe3a03001, // mov r3, #1
+        0xeafffffe, // b +#0
+    };
+
+    std::vector<std::pair<u32, size_t>> fallback_calls;
+    test_env.interpreter_fallback = [&](u32 pc, size_t num_instructions) {
+        fallback_calls.emplace_back(pc, num_instructions);
+        jit.Regs()[15] = pc + static_cast<u32>(num_instructions * 4);
+    };
+
+    jit.SetCpsr(0x000001d0); // User-mode
+
+    test_env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(fallback_calls == std::vector<std::pair<u32, size_t>>{{0, 3}});
+    REQUIRE(jit.Regs()[3] == 1);
+    REQUIRE(jit.Regs()[15] == 16);
+
+    // Single-stepping interprets only one instruction.
+    fallback_calls.clear();
+    jit.Regs()[15] = 0;
+    jit.Step();
+
+    REQUIRE(fallback_calls == std::vector<std::pair<u32, size_t>>{{0, 1}});
+    REQUIRE(jit.Regs()[15] == 4);
+}
@@ -0,0 +1,115 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <catch.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "frontend/A32/decoder/arm.h"
+#include "frontend/A32/decoder/asimd.h"
+#include "frontend/A32/decoder/thumb16.h"
+#include "frontend/A32/decoder/thumb32.h"
+#include "frontend/A32/decoder/vfp.h"
+#include "frontend/A32/translate/impl/translate_arm.h"
+#include "frontend/A32/translate/impl/translate_thumb.h"
+#include "rand_int.h"
+
+using namespace Dynarmic;
+using A32::ArmTranslatorVisitor;
+using A32::ThumbTranslatorVisitor;
+
+namespace {
+
+template <typename MatcherT>
+const char* DecodeLinear(const std::vector<MatcherT>& matchers,
+                         typename MatcherT::opcode_type instruction) {
+    const auto iter = std::find_if(matchers.begin(), matchers.end(), [instruction](const auto& m) {
+        return m.Matches(instruction);
+    });
+    return iter != matchers.end() ? iter->GetName() : nullptr;
+}
+
+template <typename DecodeResult>
+const char* NameOf(const DecodeResult& result) {
+    return result ? result->get().GetName() : nullptr;
+}
+
+template <typename T>
+std::vector<T> RandomInstructions(size_t count) {
+    std::vector<T> instructions(count);
+    std::generate(instructions.begin(), instructions.end(), [] {
+        return static_cast<T>(RandInt<u32>(0, static_cast<u32>(T(~T(0)))));
+    });
+    return instructions;
+}
+
+template <typename T, typename DecodeFn>
+void Benchmark(const char* name, const std::vector<T>& instructions, DecodeFn decode) {
+    const auto start = std::chrono::steady_clock::now();
+    size_t decoded = 0;
+    for (const T instruction : instructions) {
+        decoded += decode(instruction) ? 1 : 0;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    fmt::print("{:<24} {:>8.2f} Minst/s ({} decoded)\n", name,
+               instructions.size() / seconds / 1e6, decoded);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("A32: Decode tables agree with linear decoding", "[arm][thumb][decoder]") {
+    const auto arm = A32::GetArmMatchers<ArmTranslatorVisitor>();
+    const auto asimd = A32::GetASIMDMatchers<ArmTranslatorVisitor>();
+    const auto vfp = A32::GetVFPMatchers<ArmTranslatorVisitor>();
+    const auto thumb16 = A32::GetThumb16Matchers<ThumbTranslatorVisitor>();
+    const auto thumb32 = A32::GetThumb32Matchers<ThumbTranslatorVisitor>();
+
+    for (const u32 instruction : RandomInstructions<u32>(100000)) {
+        REQUIRE(NameOf(A32::DecodeArm<ArmTranslatorVisitor>(instruction)) ==
+                DecodeLinear(arm, instruction));
+        REQUIRE(NameOf(A32::DecodeASIMD<ArmTranslatorVisitor>(instruction)) ==
+                DecodeLinear(asimd, instruction));
+        if ((instruction & 0xF0000000) != 0xF0000000) {
+            REQUIRE(NameOf(A32::DecodeVFP<ArmTranslatorVisitor>(instruction)) ==
+                    DecodeLinear(vfp, instruction));
+        }
+        REQUIRE(NameOf(A32::DecodeThumb32<ThumbTranslatorVisitor>(instruction | 0xE0000000)) ==
+                DecodeLinear(thumb32, instruction | 0xE0000000));
+    }
+
+    for (u32 instruction = 0; instruction <= 0xFFFF; instruction++) {
+        const auto thumb_instruction = static_cast<u16>(instruction);
+        REQUIRE(NameOf(A32::DecodeThumb16<ThumbTranslatorVisitor>(thumb_instruction)) ==
+                DecodeLinear(thumb16, thumb_instruction));
+    }
+}
+
+TEST_CASE("A32: Decoder throughput", "[.][decoder][bench]") {
+    const auto arm = A32::GetArmMatchers<ArmTranslatorVisitor>();
+    const auto thumb16 = A32::GetThumb16Matchers<ThumbTranslatorVisitor>();
+    const auto arm_instructions = RandomInstructions<u32>(1000000);
+    const auto thumb_instructions = RandomInstructions<u16>(1000000);
+
+    // Warm up the decode tables so that their construction is not timed.
+    (void)A32::DecodeArm<ArmTranslatorVisitor>(0);
+    (void)A32::DecodeThumb16<ThumbTranslatorVisitor>(0);
+
+    Benchmark("ARM (linear scan)", arm_instructions,
+              [&](u32 instruction) { return DecodeLinear(arm, instruction) != nullptr; });
+    Benchmark("ARM (decode table)", arm_instructions, [](u32 instruction) {
+        return A32::DecodeArm<ArmTranslatorVisitor>(instruction).has_value();
+    });
+    Benchmark("Thumb16 (linear scan)", thumb_instructions,
+              [&](u16 instruction) { return DecodeLinear(thumb16, instruction) != nullptr; });
+    Benchmark("Thumb16 (decode table)", thumb_instructions, [](u16 instruction) {
+        return A32::DecodeThumb16<ThumbTranslatorVisitor>(instruction).has_value();
+    });
+}
@@ -3,11 +3,15 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <utility>
+#include <vector>
+
 #include <catch.hpp>
 
 #include <dynarmic/A32/a32.h>
 
 #include "common/common_types.h"
+#include "frontend/A32/translate/translate.h"
 #include "testenv.h"
 
 static Dynarmic::A32::UserConfig GetUserConfig(ThumbTestEnv* testenv) {
@@ -157,3 +161,43 @@ TEST_CASE("thumb: bl -#42", "[thumb]") {
     REQUIRE(jit.Regs()[15] == 0xFFFFFFD6);
     REQUIRE(jit.Cpsr() == 0x00000030); // Thumb, User-mode
 }
+
+TEST_CASE("thumb: Consecutive interpreted instructions are merged", "[thumb]") {
+    ThumbTestEnv test_env;
+    Dynarmic::A32::Jit jit{GetUserConfig(&test_env)};
+    test_env.code_mem = {
+        0xB662,         // cpsie i
+        0xF04F, 0x0101, // mov.w r1, #1
+        0xB672,         // cpsid i
+        0x2301,         // movs r3, #1
+        0xE7FE,         // b +#0
+    };
+
+    std::vector<std::pair<u32, size_t>> fallback_calls;
+    test_env.interpreter_fallback = [&](u32 pc, size_t num_instructions) {
+        fallback_calls.emplace_back(pc, num_instructions);
+        for (size_t i = 0; i < num_instructions; i++) {
+            const u16 first_part = test_env.code_mem[pc / 2];
+            pc += Dynarmic::A32::IsThumb16(first_part) ? 2 : 4;
+        }
+        jit.Regs()[15] = pc;
+    };
+
+    jit.Regs()[15] = 0;      // PC = 0
+    jit.SetCpsr(0x00000030); // Thumb, User-mode
+
+    test_env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(fallback_calls == std::vector<std::pair<u32, size_t>>{{0, 3}});
+    REQUIRE(jit.Regs()[3] == 1);
+    REQUIRE(jit.Regs()[15] == 10);
+
+    // Single-stepping interprets only one instruction.
+    fallback_calls.clear();
+    jit.Regs()[15] = 2;
+    jit.Step();
+
+    REQUIRE(fallback_calls == std::vector<std::pair<u32, size_t>>{{2, 1}});
+    REQUIRE(jit.Regs()[15] == 6);
+}
@@ -7,6 +7,7 @@
 
 #include <array>
 #include <cstring>
+#include <functional>
 #include <map>
 #include <string>
 #include <vector>
@@ -27,7 +28,10 @@ public:
     bool code_mem_modified_by_guest = false;
     std::vector<InstructionType> code_mem;
     std::map<u32, u8> modified_memory;
+    std::map<u32, void*> translated_pages;
+    size_t translate_address_calls = 0;
     std::vector<std::string> interrupts;
+    std::function<void(u32 pc, size_t num_instructions)> interpreter_fallback;
 
     std::uint32_t MemoryReadCode(u32 vaddr) override {
         const size_t index = vaddr / sizeof(InstructionType);
@@ -77,7 +81,19 @@ public:
         MemoryWrite32(vaddr + 4, static_cast<u32>(value >> 32));
     }
 
+    void* TranslateAddress(u32 vaddr) override {
+        translate_address_calls++;
+        if (auto iter = translated_pages.find(vaddr); iter != translated_pages.end()) {
+            return iter->second;
+        }
+        return nullptr;
+    }
+
     void InterpreterFallback(u32 pc, size_t num_instructions) override {
+        if (interpreter_fallback) {
+            interpreter_fallback(pc, num_instructions);
+            return;
+        }
         ASSERT_MSG(false, "InterpreterFallback({:08x}, {}) code = {:08x}", pc, num_instructions,
                    MemoryReadCode(pc));
     }
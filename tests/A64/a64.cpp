@@ -3,11 +3,19 @@
  * SPDX-License-Identifier: 0BSD
  */
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include <catch.hpp>
 
 #include <dynarmic/A64/exclusive_monitor.h>
 
+#include "common/bit_util.h"
 #include "common/fp/fpsr.h"
+#include "frontend/A64/decoder/a64.h"
+#include "frontend/A64/translate/impl/impl.h"
+#include "rand_int.h"
 #include "testenv.h"
 
 namespace FP = Dynarmic::FP;
@@ -313,6 +321,485 @@ TEST_CASE("A64: 128-bit exclusive read/write", "[a64]") {
     REQUIRE(env.MemoryRead64(0x1234567812345680) == 0xd0d0cacad0d0caca);
 }
 
+TEST_CASE("A64: LSE atomics", "[a64]") {
+    A64TestEnv env;
+    std::array<void*, 256> page_table{};
+    alignas(16) std::array<u8, 4096> page{};
+    for (size_t i = 0; i < page.size(); i++) {
+        page[i] = static_cast<u8>(i);
+    }
+
+    Dynarmic::A64::UserConfig conf{&env};
+
+    SECTION("Callbacks") {}
+
+    SECTION("Page table") {
+        page_table[1] = page.data();
+        conf.page_table = page_table.data();
+        conf.page_table_address_space_bits = 20;
+    }
+
+    SECTION("Page table fallback") {
+        conf.page_table = page_table.data();
+        conf.page_table_address_space_bits = 20;
+    }
+
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf8210002); // LDADD X1, X2, [X0]
+    env.code_mem.emplace_back(0xc8a37c04); // CAS X3, X4, [X0]
+    env.code_mem.emplace_back(0x38256006); // LDUMAXB W5, W6, [X0]
+    env.code_mem.emplace_back(0x78278008); // SWPH W7, W8, [X0]
+    env.code_mem.emplace_back(0xb829100a); // LDCLR W9, W10, [X0]
+    env.code_mem.emplace_back(0x482c7c0e); // CASP X12, X13, X14, X15, [X0]
+    env.code_mem.emplace_back(0x38345015); // LDSMINB W20, W21, [X0]
+    env.code_mem.emplace_back(0xf9400010); // LDR X16, [X0]
+    env.code_mem.emplace_back(0xf9400411); // LDR X17, [X0, #8]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 0x1000);
+    jit.SetRegister(1, 1);
+    jit.SetRegister(3, 0x0706050403020101);
+    jit.SetRegister(4, 0x1111);
+    jit.SetRegister(5, 0x80);
+    jit.SetRegister(7, 0xbeef);
+    jit.SetRegister(9, 0xff);
+    jit.SetRegister(12, 0xbe00);
+    jit.SetRegister(13, 0x0f0e0d0c0b0a0908);
+    jit.SetRegister(14, 0xaaaa);
+    jit.SetRegister(15, 0xbbbb);
+    jit.SetRegister(20, 0x80);
+
+    env.ticks_left = 10;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(2) == 0x0706050403020100);
+    REQUIRE(jit.GetRegister(3) == 0x0706050403020101);
+    REQUIRE(jit.GetRegister(6) == 0x11);
+    REQUIRE(jit.GetRegister(8) == 0x1180);
+    REQUIRE(jit.GetRegister(10) == 0xbeef);
+    REQUIRE(jit.GetRegister(12) == 0xbe00);
+    REQUIRE(jit.GetRegister(13) == 0x0f0e0d0c0b0a0908);
+    REQUIRE(jit.GetRegister(21) == 0xaa);
+    REQUIRE(jit.GetRegister(16) == 0xaa80);
+    REQUIRE(jit.GetRegister(17) == 0xbbbb);
+}
+
+TEST_CASE("A64: Two-level page table", "[a64]") {
+    A64TestEnv env;
+    std::vector<void*> root(1 << 18);
+    std::vector<void*> leaf(1 << 18);
+    std::array<u64, 512> page{};
+    page[1] = 0x1122334455667788;
+
+    root[0x1fffc] = leaf.data();
+    leaf[0x12345] = page.data();
+
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.page_table = root.data();
+    conf.page_table_address_space_bits = 48;
+    conf.page_table_levels = 2;
+    conf.silently_mirror_page_table = false;
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf9000001); // STR X1, [X0]
+    env.code_mem.emplace_back(0xf9400402); // LDR X2, [X0, #8]
+    env.code_mem.emplace_back(0xf9400083); // LDR X3, [X4]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 0x7fff12345000);
+    jit.SetRegister(1, 0xdeadbeefcafebabe);
+    jit.SetRegister(4, 0x7fff00000000);
+
+    env.ticks_left = 4;
+    jit.Run();
+
+    REQUIRE(page[0] == 0xdeadbeefcafebabe);
+    REQUIRE(jit.GetRegister(2) == 0x1122334455667788);
+    REQUIRE(jit.GetRegister(3) == 0x0706050403020100);
+    REQUIRE(env.modified_memory.empty());
+}
+
+TEST_CASE("A64: Software TLB", "[a64]") {
+    A64TestEnv env;
+    std::array<u64, 512> page_a{};
+    std::array<u64, 512> page_b{};
+    page_a[1] = 0x1122334455667788;
+    page_b[1] = 0x8877665544332211;
+    env.translated_pages[0x10000] = page_a.data();
+
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.enable_software_tlb = true;
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf9000001); // STR X1, [X0]
+    env.code_mem.emplace_back(0xf9400402); // LDR X2, [X0, #8]
+    env.code_mem.emplace_back(0xf9400083); // LDR X3, [X4]
+    env.code_mem.emplace_back(0xf85fc005); // LDUR X5, [X0, #-4]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 0x10000);
+    jit.SetRegister(1, 0xdeadbeefcafebabe);
+    jit.SetRegister(4, 0x20000);
+
+    env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(page_a[0] == 0xdeadbeefcafebabe);
+    REQUIRE(jit.GetRegister(2) == 0x1122334455667788);
+    REQUIRE(jit.GetRegister(3) == 0x0706050403020100);
+    REQUIRE(jit.GetRegister(5) == 0x03020100fffefdfc);
+    REQUIRE(env.translate_address_calls == 2);
+    REQUIRE(env.modified_memory.empty());
+
+    // Remapped pages are picked up once the TLB is flushed.
+    env.translated_pages[0x10000] = page_b.data();
+    jit.FlushSoftwareTLB();
+
+    jit.SetPC(0);
+    env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(page_b[0] == 0xdeadbeefcafebabe);
+    REQUIRE(jit.GetRegister(2) == 0x8877665544332211);
+}
+
+TEST_CASE("A64: Flat memory", "[a64]") {
+    A64TestEnv env;
+    std::vector<u64> memory((0x10000 + 16) / sizeof(u64));
+    memory[0x801] = 0x1122334455667788;
+
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.flat_memory_base = reinterpret_cast<u8*>(memory.data());
+    conf.flat_memory_mask = 0xFFFF;
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf9000001); // STR X1, [X0]
+    env.code_mem.emplace_back(0xf9400402); // LDR X2, [X0, #8]
+    env.code_mem.emplace_back(0xf9400083); // LDR X3, [X4]
+    env.code_mem.emplace_back(0xf8250006); // LDADD X5, X6, [X0]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 0x4000);
+    jit.SetRegister(1, 0xdeadbeefcafebabe);
+    jit.SetRegister(4, 0x7fff00004008);
+    jit.SetRegister(5, 1);
+
+    env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(memory[0x800] == 0xdeadbeefcafebabf);
+    REQUIRE(jit.GetRegister(2) == 0x1122334455667788);
+    REQUIRE(jit.GetRegister(3) == 0x1122334455667788);
+    REQUIRE(jit.GetRegister(6) == 0xdeadbeefcafebabe);
+    REQUIRE(env.modified_memory.empty());
+}
+
+TEST_CASE("A64: Conditional loop reuses host flags", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.code_mem.emplace_back(0xf1000400); // SUBS X0, X0, #1
+    env.code_mem.emplace_back(0x9a838041); // CSEL X1, X2, X3, HI
+    env.code_mem.emplace_back(0x9a84b484); // CINC X4, X4, GE
+    env.code_mem.emplace_back(0x54ffffa1); // B.NE #-12
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 10);
+    jit.SetRegister(1, 0);
+    jit.SetRegister(2, 2);
+    jit.SetRegister(3, 3);
+    jit.SetRegister(4, 0);
+
+    env.ticks_left = 100;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(0) == 0);
+    REQUIRE(jit.GetRegister(1) == 3);
+    REQUIRE(jit.GetRegister(4) == 10);
+    REQUIRE(jit.GetPstate() == 0x60000000);
+    REQUIRE(jit.GetPC() == 16);
+}
+
+TEST_CASE("A64: Self-looping block", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.code_mem.emplace_back(0x38401402); // LDRB W2, [X0], #1
+    env.code_mem.emplace_back(0x91000421); // ADD X1, X1, #1
+    env.code_mem.emplace_back(0x35ffffc2); // CBNZ W2, #-8
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 0x1001);
+    jit.SetRegister(1, 0);
+
+    // Guest registers must be written back when the cycle budget runs out mid-loop.
+    env.ticks_left = 30;
+    jit.Run();
+
+    REQUIRE(jit.GetPC() == 0);
+    REQUIRE(jit.GetRegister(0) == 0x100B);
+    REQUIRE(jit.GetRegister(1) == 10);
+    REQUIRE(jit.GetRegister(2) == 0x0A);
+
+    env.ticks_left = 1000;
+    jit.Run();
+
+    REQUIRE(jit.GetPC() == 12);
+    REQUIRE(jit.GetRegister(0) == 0x1101);
+    REQUIRE(jit.GetRegister(1) == 0x100);
+    REQUIRE(jit.GetRegister(2) == 0);
+}
+
+TEST_CASE("A64: Cross-block flag elimination", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.optimizations |= Dynarmic::OptimizationFlag::CrossBlockFlagElimination;
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf1000400); // SUBS X0, X0, #1
+    env.code_mem.emplace_back(0x14000001); // B #4
+    env.code_mem.emplace_back(0xeb02003f); // CMP X1, X2
+    env.code_mem.emplace_back(0x9a9f17e3); // CSET X3, EQ
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetPstate(0);
+    jit.SetRegister(0, 0);
+    jit.SetRegister(1, 42);
+    jit.SetRegister(2, 42);
+
+    // The successor overwrites NZCV, so the first block does not update it.
+    env.ticks_left = 2;
+    jit.Run();
+
+    REQUIRE(jit.GetPC() == 8);
+    REQUIRE(jit.GetRegister(0) == 0xFFFFFFFFFFFFFFFF);
+    REQUIRE(jit.GetPstate() == 0);
+
+    env.ticks_left = 10;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(3) == 1);
+    REQUIRE(jit.GetPstate() == 0x60000000);
+
+    // Invalidating the successor also invalidates the first block, which now must update NZCV.
+    env.code_mem[2] = 0x9a9f57e3; // CSET X3, MI
+    env.code_mem[3] = 0xd503201f; // NOP
+    jit.InvalidateCacheRange(8, 4);
+
+    jit.SetPC(0);
+    jit.SetPstate(0);
+    jit.SetRegister(0, 0);
+    jit.SetRegister(3, 0);
+
+    env.ticks_left = 4;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(3) == 1);
+    REQUIRE(jit.GetPstate() == 0x80000000);
+}
+
+TEST_CASE("A64: Common subexpression elimination", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.code_mem.emplace_back(0x8b020c01); // ADD X1, X0, X2, LSL #3
+    env.code_mem.emplace_back(0x8b020c03); // ADD X3, X0, X2, LSL #3
+    env.code_mem.emplace_back(0xd344fc04); // LSR X4, X0, #4
+    env.code_mem.emplace_back(0xd348fc05); // LSR X5, X0, #8
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, 0x1234);
+    jit.SetRegister(2, 0x10);
+
+    env.ticks_left = 5;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(1) == 0x12B4);
+    REQUIRE(jit.GetRegister(3) == 0x12B4);
+    REQUIRE(jit.GetRegister(4) == 0x123);
+    REQUIRE(jit.GetRegister(5) == 0x12);
+}
+
+TEST_CASE("A64: Memory forwarding", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.optimizations |= Dynarmic::OptimizationFlag::MemoryForwarding;
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf90007e1); // STR X1, [SP, #8]
+    env.code_mem.emplace_back(0xf94007e2); // LDR X2, [SP, #8]
+    env.code_mem.emplace_back(0xb9000fe3); // STR W3, [SP, #12]
+    env.code_mem.emplace_back(0xf94007e4); // LDR X4, [SP, #8]
+    env.code_mem.emplace_back(0xf90000c7); // STR X7, [X6]
+    env.code_mem.emplace_back(0xf94007e5); // LDR X5, [SP, #8]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetSP(0x1000);
+    jit.SetRegister(1, 0x1111111122222222);
+    jit.SetRegister(3, 0x33333333);
+    jit.SetRegister(6, 0x1008);
+    jit.SetRegister(7, 0x7777777777777777);
+
+    env.ticks_left = 7;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(2) == 0x1111111122222222);
+    REQUIRE(jit.GetRegister(4) == 0x3333333322222222);
+    REQUIRE(jit.GetRegister(5) == 0x7777777777777777);
+}
+
+TEST_CASE("A64: Paired memory accesses", "[a64]") {
+    A64TestEnv env;
+    std::array<void*, 256> page_table{};
+    alignas(16) std::array<u8, 4096> page{};
+    page_table[1] = page.data();
+
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.optimizations &= ~Dynarmic::OptimizationFlag::MemoryForwarding;
+    u64 pair_address = 0x1200;
+
+    SECTION("Callbacks") {}
+
+    SECTION("Page table") {
+        conf.page_table = page_table.data();
+        conf.page_table_address_space_bits = 20;
+    }
+
+    SECTION("Page table page crossing") {
+        conf.page_table = page_table.data();
+        conf.page_table_address_space_bits = 20;
+        pair_address = 0x1FFC;
+    }
+
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xa9bf0be1); // STP X1, X2, [SP, #-16]!
+    env.code_mem.emplace_back(0x29001003); // STP W3, W4, [X0]
+    env.code_mem.emplace_back(0xa8c11be5); // LDP X5, X6, [SP], #16
+    env.code_mem.emplace_back(0x29402007); // LDP W7, W8, [X0]
+    env.code_mem.emplace_back(0x293f13e3); // STP W3, W4, [SP, #-8]
+    env.code_mem.emplace_back(0x297f2be9); // LDP W9, W10, [SP, #-8]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetSP(0x1100);
+    jit.SetRegister(0, pair_address);
+    jit.SetRegister(1, 0x1111111111111111);
+    jit.SetRegister(2, 0x2222222222222222);
+    jit.SetRegister(3, 0x33333333);
+    jit.SetRegister(4, 0x44444444);
+
+    env.ticks_left = 7;
+    jit.Run();
+
+    REQUIRE(jit.GetSP() == 0x1100);
+    REQUIRE(jit.GetRegister(5) == 0x1111111111111111);
+    REQUIRE(jit.GetRegister(6) == 0x2222222222222222);
+    REQUIRE(jit.GetRegister(7) == 0x33333333);
+    REQUIRE(jit.GetRegister(8) == 0x44444444);
+    REQUIRE(jit.GetRegister(9) == 0x33333333);
+    REQUIRE(jit.GetRegister(10) == 0x44444444);
+
+    if (conf.page_table) {
+        REQUIRE(page[0x0F0] == 0x11);
+        REQUIRE(page[0x0F8] == 0x33);
+    }
+    if (pair_address == 0x1FFC) {
+        // Accesses which would cross into another page are performed through callbacks.
+        REQUIRE(env.MemoryRead32(0x1FFC) == 0x33333333);
+        REQUIRE(env.MemoryRead32(0x2000) == 0x44444444);
+    }
+}
+
+TEST_CASE("A64: Shared page lookups", "[a64]") {
+    A64TestEnv env;
+    std::array<void*, 256> page_table{};
+    alignas(4096) std::array<u8, 4096> page{};
+    for (size_t i = 0; i < page.size(); i++) {
+        // Differs from what the memory callbacks return for the same address.
+        page[i] = static_cast<u8>(~i);
+    }
+
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.page_table = page_table.data();
+    conf.page_table_address_space_bits = 20;
+    u64 base = 0x1100;
+    bool mapped = true;
+
+    std::array<std::array<void*, 512>, 4> levels{};
+
+    SECTION("Page table") {
+        page_table[1] = page.data();
+    }
+
+    SECTION("Page table identity mapping") {
+        // Guest and host addresses of the page are the same.
+        base = reinterpret_cast<u64>(page.data()) + 0x100;
+        for (size_t level = 0; level < levels.size(); level++) {
+            const size_t index = (base >> (12 + 9 * (3 - level))) & 0x1FF;
+            levels[level][index] =
+                level == 3 ? static_cast<void*>(page.data()) : levels[level + 1].data();
+        }
+        conf.page_table = levels[0].data();
+        conf.page_table_address_space_bits = 48;
+        conf.page_table_levels = 4;
+    }
+
+    SECTION("Page table fallback") {
+        mapped = false;
+    }
+
+    SECTION("Page table page crossing") {
+        page_table[1] = page.data();
+        base = 0x1FE8;
+        mapped = false;
+    }
+
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xf9400401); // LDR X1, [X0, #8]
+    env.code_mem.emplace_back(0xb9401002); // LDR W2, [X0, #16]
+    env.code_mem.emplace_back(0x39405403); // LDRB W3, [X0, #21]
+    env.code_mem.emplace_back(0xf9000c04); // STR X4, [X0, #24]
+    env.code_mem.emplace_back(0x79004405); // STRH W5, [X0, #34]
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(0, base);
+    jit.SetRegister(4, 0x4444444444444444);
+    jit.SetRegister(5, 0x5555);
+
+    env.ticks_left = 6;
+    jit.Run();
+
+    if (mapped) {
+        REQUIRE(jit.GetRegister(1) == 0xf0f1f2f3f4f5f6f7);
+        REQUIRE(jit.GetRegister(2) == 0xecedeeef);
+        REQUIRE(jit.GetRegister(3) == 0xea);
+        REQUIRE(page[0x118] == 0x44);
+        REQUIRE(page[0x11F] == 0x44);
+        REQUIRE(page[0x122] == 0x55);
+        REQUIRE(page[0x123] == 0x55);
+        REQUIRE(env.modified_memory.empty());
+    } else {
+        REQUIRE(jit.GetRegister(1) == env.MemoryRead64(base + 8));
+        REQUIRE(jit.GetRegister(2) == env.MemoryRead32(base + 16));
+        REQUIRE(jit.GetRegister(3) == static_cast<u8>(base + 21));
+        REQUIRE(env.MemoryRead64(base + 24) == 0x4444444444444444);
+        REQUIRE(env.MemoryRead16(base + 34) == 0x5555);
+    }
+}
+
 TEST_CASE("A64: CNTPCT_EL0", "[a64]") {
     A64TestEnv env;
     Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
@@ -634,3 +1121,257 @@ TEST_CASE("A64: Optimization failure when folding ADD", "[a64]") {
     REQUIRE(jit.GetPstate() == 0x20000000);
     REQUIRE(jit.GetVector(30) == Vector{0xf7f6f5f4, 0});
 }
+
+TEST_CASE("A64: Algebraic simplification", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.code_mem.emplace_back(0xd2800101); // MOV X1, #8
+    env.code_mem.emplace_back(0x9b017c40); // MUL X0, X2, X1
+    env.code_mem.emplace_back(0x4a040083); // EOR W3, W4, W4
+    env.code_mem.emplace_back(0xcb090128); // SUB X8, X9, X9
+    env.code_mem.emplace_back(0x6e211c20); // EOR V0.16B, V1.16B, V1.16B
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetRegister(2, 0x1234567812345678);
+    jit.SetRegister(3, 0xFFFFFFFF);
+    jit.SetRegister(4, 0xDEADBEEFDEADBEEF);
+    jit.SetRegister(8, 0xFFFFFFFF);
+    jit.SetRegister(9, 0xCAFEBABE);
+    jit.SetVector(0, {0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF});
+    jit.SetVector(1, {0x0123456789ABCDEF, 0xFEDCBA9876543210});
+
+    env.ticks_left = 6;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(0) == 0x91A2B3C091A2B3C0);
+    REQUIRE(jit.GetRegister(1) == 8);
+    REQUIRE(jit.GetRegister(3) == 0);
+    REQUIRE(jit.GetRegister(8) == 0);
+    REQUIRE(jit.GetVector(0) == Vector{0, 0});
+}
+
+TEST_CASE("A64: Vector and floating-point constant folding", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.code_mem.emplace_back(0x4f000420); // MOVI V0.4S, #1
+    env.code_mem.emplace_back(0x4f000441); // MOVI V1.4S, #2
+    env.code_mem.emplace_back(0x4ea18402); // ADD V2.4S, V0.4S, V1.4S
+    env.code_mem.emplace_back(0x1e2e1003); // FMOV S3, #1.0
+    env.code_mem.emplace_back(0x1e2c1004); // FMOV S4, #0.5
+    env.code_mem.emplace_back(0x1e242865); // FADD S5, S3, S4
+    env.code_mem.emplace_back(0x1e240866); // FMUL S6, S3, S4
+    env.code_mem.emplace_back(0x1e243867); // FSUB S7, S3, S4
+    env.code_mem.emplace_back(0x1e611008); // FMOV D8, #3.0
+    env.code_mem.emplace_back(0x1e68290a); // FADD D10, D8, D8
+    env.code_mem.emplace_back(0x14000000); // B .
+
+    jit.SetPC(0);
+    jit.SetFpsr(0);
+
+    env.ticks_left = 11;
+    jit.Run();
+
+    REQUIRE(jit.GetVector(2) == Vector{0x0000000300000003, 0x0000000300000003});
+    REQUIRE(jit.GetVector(5) == Vector{0x3FC00000, 0});
+    REQUIRE(jit.GetVector(6) == Vector{0x3F000000, 0});
+    REQUIRE(jit.GetVector(7) == Vector{0x3F000000, 0});
+    REQUIRE(jit.GetVector(10) == Vector{0x4018000000000000, 0});
+    REQUIRE(jit.GetFpsr() == 0);
+}
+
+TEST_CASE("A64: Reads from read-only memory are folded", "[a64]") {
+    A64TestEnv env;
+    env.code_mem_is_read_only = true;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.code_mem.emplace_back(0x58000081); // LDR X1, #16
+    env.code_mem.emplace_back(0xd2840003); // MOV X3, #0x2000
+    env.code_mem.emplace_back(0xf9400062); // LDR X2, [X3]
+    env.code_mem.emplace_back(0x14000000); // B .
+    env.code_mem.emplace_back(0x11111111);
+    env.code_mem.emplace_back(0x11111111);
+
+    env.MemoryWrite64(0x2000, 0x2222222222222222);
+
+    jit.SetPC(0);
+    env.ticks_left = 4;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(1) == 0x1111111111111111);
+    REQUIRE(jit.GetRegister(2) == 0x2222222222222222);
+
+    // The compiled block has the read-only value built in, but still reads writable memory.
+    env.code_mem[4] = 0x33333333;
+    env.MemoryWrite64(0x2000, 0x4444444444444444);
+
+    jit.SetPC(0);
+    env.ticks_left = 4;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(1) == 0x1111111111111111);
+    REQUIRE(jit.GetRegister(2) == 0x4444444444444444);
+}
+
+TEST_CASE("A64: Decode table agrees with linear decoding", "[a64][decoder]") {
+    using Dynarmic::A64::TranslatorVisitor;
+
+    struct LinearMatcher {
+        std::string name;
+        u32 mask;
+        u32 expected;
+    };
+
+    const auto make_matcher = [](const char* name, const char* bitstring) {
+        const auto [mask, expected] =
+            Dynarmic::A64::detail::MatcherDetail::GetMaskAndExpect(bitstring);
+        return LinearMatcher{name, mask, expected};
+    };
+
+    // The ordering the decoder used before its table was generated at compile time.
+    std::vector<LinearMatcher> matchers{
+#define INST(fn, name, bitstring) make_matcher(name, bitstring),
+#include "frontend/A64/decoder/a64.inc"
+#undef INST
+    };
+    std::stable_sort(matchers.begin(), matchers.end(), [](const auto& m1, const auto& m2) {
+        return Dynarmic::Common::BitCount(m1.mask) > Dynarmic::Common::BitCount(m2.mask);
+    });
+    std::stable_partition(matchers.begin(), matchers.end(), [](const auto& m) {
+        return m.name == "MOVI, MVNI, ORR, BIC (vector, immediate)" ||
+               m.name == "FMOV (vector, immediate)" ||
+               m.name == "Unallocated SIMD modified immediate";
+    });
+
+    const auto name_of = [](u32 instruction) -> std::string {
+        const auto matcher = Dynarmic::A64::Decode<TranslatorVisitor>(instruction);
+        return matcher ? matcher->get().GetName() : "";
+    };
+    const auto linear_name_of = [&](u32 instruction) -> std::string {
+        const auto iter = std::find_if(matchers.begin(), matchers.end(), [&](const auto& m) {
+            return (instruction & m.mask) == m.expected;
+        });
+        return iter != matchers.end() ? iter->name : "";
+    };
+
+    for (size_t i = 0; i < 100000; i++) {
+        const u32 instruction = RandInt<u32>(0, 0xFFFFFFFF);
+        REQUIRE(name_of(instruction) == linear_name_of(instruction));
+    }
+
+    // MOVI is more general than some of the instructions which overlap with it.
+    REQUIRE(name_of(0x4f000420) == "MOVI, MVNI, ORR, BIC (vector, immediate)");
+    REQUIRE(name_of(0x4f03f600) == "FMOV (vector, immediate)");
+    REQUIRE(name_of(0x6f03f600) == "FMOV (vector, immediate)");
+    REQUIRE(name_of(0x8b020020) == "ADD (shifted register)");
+}
+
+TEST_CASE("A64: Code is read directly from host memory", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::Jit jit{Dynarmic::A64::UserConfig{&env}};
+
+    env.provide_code_pointers = true;
+    env.code_mem.resize(1024, 0x14000000); // B .
+    std::fill_n(env.code_mem.begin(), 100, 0x91000400); // ADD X0, X0, #1
+
+    jit.SetRegister(0, 0);
+    jit.SetPC(0);
+
+    env.ticks_left = 101;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(0) == 100);
+    REQUIRE(jit.GetPC() == 400);
+    REQUIRE(env.get_code_pointer_calls == 1);
+}
+
+TEST_CASE("A64: Blocks are limited to max_instructions_per_block", "[a64]") {
+    A64TestEnv env;
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.max_instructions_per_block = 10;
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.resize(101, 0x91000400); // ADD X0, X0, #1
+    env.code_mem.back() = 0x14000000;     // B .
+
+    jit.SetRegister(0, 0);
+    jit.SetPC(0);
+
+    // Without the limit, all 100 instructions would be executed in a single block.
+    env.ticks_left = 10;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(0) == 10);
+    REQUIRE(jit.GetPC() == 40);
+
+    env.ticks_left = 91;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(0) == 100);
+    REQUIRE(jit.GetPC() == 400);
+}
+
+TEST_CASE("A64: Custom IR pass order", "[a64]") {
+    A64TestEnv env;
+    env.code_mem_is_read_only = true;
+    Dynarmic::A64::UserConfig conf{&env};
+    conf.optimizations = Dynarmic::OptimizationFlag::GetSetElimination |
+                         Dynarmic::OptimizationFlag::ConstantPropagation |
+                         Dynarmic::OptimizationFlag::ConstantMemoryReads |
+                         Dynarmic::OptimizationFlag::Verification;
+
+    // The address of the load only becomes an immediate after GetSetElimination and
+    // ConstantPropagation, so the load is folded only if ConstantMemoryReads runs after them.
+    bool folded = false;
+    SECTION("ConstantMemoryReads after GetSetElimination") {
+        conf.pass_order = {
+            Dynarmic::OptimizationFlag::GetSetElimination,
+            Dynarmic::OptimizationFlag::ConstantPropagation,
+            Dynarmic::OptimizationFlag::ConstantMemoryReads,
+        };
+        folded = true;
+    }
+    SECTION("ConstantMemoryReads before GetSetElimination") {
+        conf.pass_order = {
+            Dynarmic::OptimizationFlag::ConstantMemoryReads,
+            Dynarmic::OptimizationFlag::GetSetElimination,
+            Dynarmic::OptimizationFlag::ConstantPropagation,
+        };
+        folded = false;
+    }
+    SECTION("Passes which are not enabled are skipped") {
+        conf.pass_order = {
+            Dynarmic::OptimizationFlag::GetSetElimination,
+            Dynarmic::OptimizationFlag::ConstantPropagation,
+            Dynarmic::OptimizationFlag::ConstantMemoryReads,
+        };
+        conf.optimizations &= ~Dynarmic::OptimizationFlag::GetSetElimination;
+        folded = false;
+    }
+
+    Dynarmic::A64::Jit jit{conf};
+
+    env.code_mem.emplace_back(0xd2800203); // MOV X3, #0x10
+    env.code_mem.emplace_back(0xf9400062); // LDR X2, [X3]
+    env.code_mem.emplace_back(0x14000000); // B .
+    env.code_mem.emplace_back(0xd503201f); // NOP
+    env.code_mem.emplace_back(0x11111111);
+    env.code_mem.emplace_back(0x11111111);
+
+    jit.SetPC(0);
+    env.ticks_left = 3;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(2) == 0x1111111111111111);
+
+    // Only a folded load keeps the value from when the block was compiled.
+    env.code_mem[4] = 0x33333333;
+
+    jit.SetPC(0);
+    env.ticks_left = 3;
+    jit.Run();
+
+    REQUIRE(jit.GetRegister(2) == (folded ? 0x1111111111111111 : 0x1111111133333333));
+}
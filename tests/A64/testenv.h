@@ -24,7 +24,12 @@ public:
     std::vector<u32> code_mem;
 
     std::map<u64, u8> modified_memory;
+    std::map<u64, void*> translated_pages;
+    size_t translate_address_calls = 0;
     std::vector<std::string> interrupts;
+    bool provide_code_pointers = false;
+    size_t get_code_pointer_calls = 0;
+    bool code_mem_is_read_only = false;
 
     bool IsInCodeMem(u64 vaddr) const {
         return vaddr >= code_mem_start_address &&
@@ -40,6 +45,18 @@ public:
         return code_mem[index];
     }
 
+    const std::uint8_t* GetCodePointer(u64 vaddr) override {
+        get_code_pointer_calls++;
+        if (!provide_code_pointers || !IsInCodeMem(vaddr) || !IsInCodeMem(vaddr + 4095)) {
+            return nullptr;
+        }
+        return reinterpret_cast<const u8*>(code_mem.data()) + (vaddr - code_mem_start_address);
+    }
+
+    bool IsReadOnlyMemory(u64 vaddr) override {
+        return code_mem_is_read_only && IsInCodeMem(vaddr);
+    }
+
     std::uint8_t MemoryRead8(u64 vaddr) override {
         if (IsInCodeMem(vaddr)) {
             return reinterpret_cast<u8*>(code_mem.data())[vaddr - code_mem_start_address];
@@ -111,6 +128,14 @@ public:
         return true;
     }
 
+    void* TranslateAddress(u64 vaddr) override {
+        translate_address_calls++;
+        if (auto iter = translated_pages.find(vaddr); iter != translated_pages.end()) {
+            return iter->second;
+        }
+        return nullptr;
+    }
+
     void InterpreterFallback(u64 pc, size_t num_instructions) override {
         ASSERT_MSG(false, "InterpreterFallback({:016x}, {})", pc, num_instructions);
     }
@@ -0,0 +1,410 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <dynarmic/A64/exclusive_monitor.h>
+#include <fmt/format.h>
+
+#include "A32/testenv.h"
+#include "A64/testenv.h"
+#include "backend/x64/a32_emit_x64.h"
+#include "backend/x64/a32_jitstate.h"
+#include "backend/x64/a64_emit_x64.h"
+#include "backend/x64/a64_jitstate.h"
+#include "backend/x64/block_of_code.h"
+#include "backend/x64/callback.h"
+#include "backend/x64/devirtualize.h"
+#include "backend/x64/jitstate_info.h"
+#include "common/common_types.h"
+#include "frontend/A32/decoder/thumb16.h"
+#include "frontend/A32/decoder/thumb32.h"
+#include "frontend/A32/location_descriptor.h"
+#include "frontend/A32/translate/impl/translate_thumb.h"
+#include "frontend/A32/translate/translate.h"
+#include "frontend/A64/location_descriptor.h"
+#include "frontend/A64/translate/translate.h"
+#include "frontend/code_reader.h"
+#include "frontend/ir/basic_block.h"
+#include "fuzz_util.h"
+#include "ir_opt/passes.h"
+#include "rand_int.h"
+
+/*
+ * Measures the throughput of each stage of the JIT compiler: translation to IR, IR passes and
+ * emission of host code. Corpora of guest code are compiled block by block exactly as the JIT
+ * would compile them, but the emitted code is never executed.
+ *
+ * Usage: dynarmic_bench_translate [instruction_count] [iterations]
+ * instruction_count is the size of each corpus in 32-bit words, or halfwords for Thumb.
+ */
+
+using namespace Dynarmic;
+using namespace Dynarmic::Backend::X64;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    size_t guest_instructions = 0;
+    size_t ir_instructions = 0;
+    size_t host_bytes = 0;
+    Clock::duration translate{};
+    Clock::duration optimize{};
+    Clock::duration emit{};
+
+    Result& operator+=(const Result& other) {
+        guest_instructions += other.guest_instructions;
+        ir_instructions += other.ir_instructions;
+        host_bytes += other.host_bytes;
+        translate += other.translate;
+        optimize += other.optimize;
+        emit += other.emit;
+        return *this;
+    }
+};
+
+CodePtr LookupBlock(void*) {
+    return nullptr;
+}
+
+/// Emits host code for blocks of IR as the JIT would.
+template <typename EmitterT, typename JitStateT, typename UserConfigT>
+class Backend {
+public:
+    explicit Backend(const UserConfigT& conf)
+        : block_of_code(GenRunCodeCallbacks(conf.callbacks), JitStateInfo{jit_state},
+                        [](BlockOfCode&) {}),
+          emitter(block_of_code, conf, nullptr) {}
+
+    /// Clears the code cache if there may not be enough space to emit another block.
+    void EnsureSpace() {
+        constexpr size_t MINIMUM_REMAINING_CODESIZE = 1 * 1024 * 1024;
+        if (block_of_code.SpaceRemaining() < MINIMUM_REMAINING_CODESIZE) {
+            Clear();
+        }
+    }
+
+    void Clear() {
+        block_of_code.ClearCache();
+        emitter.ClearCache();
+    }
+
+    /// Returns the size of the emitted code in bytes.
+    size_t Emit(IR::Block& block) {
+        return emitter.Emit(block).size;
+    }
+
+private:
+    template <typename UserCallbacks>
+    static RunCodeCallbacks GenRunCodeCallbacks(UserCallbacks* cb) {
+        return RunCodeCallbacks{
+            std::make_unique<ArgCallback>(&LookupBlock, 0),
+            std::make_unique<ArgCallback>(Devirtualize<&UserCallbacks::AddTicks>(cb)),
+            std::make_unique<ArgCallback>(Devirtualize<&UserCallbacks::GetTicksRemaining>(cb)),
+        };
+    }
+
+    JitStateT jit_state;
+    BlockOfCode block_of_code;
+    EmitterT emitter;
+};
+
+/// Compiles every block from location up to end_pc, timing each stage.
+template <typename LocationDescriptor, typename TranslateFn, typename OptimizeFn,
+          typename BackendT>
+Result CompileAll(LocationDescriptor location, u64 end_pc, TranslateFn translate,
+                  OptimizeFn optimize, BackendT& backend) {
+    Result result;
+    while (location.PC() < end_pc) {
+        backend.EnsureSpace();
+
+        const auto start = Clock::now();
+        IR::Block block = translate(location);
+        const auto translated = Clock::now();
+        size_t guest_instructions = block.CycleCount();
+        if (LocationDescriptor{block.EndLocation()}.PC() > end_pc) {
+            // Code past the end of the corpus reads as a branch to itself, which ends the block.
+            guest_instructions--;
+        }
+        optimize(block);
+        const auto optimized = Clock::now();
+        result.host_bytes += backend.Emit(block);
+        const auto emitted = Clock::now();
+
+        result.guest_instructions += guest_instructions;
+        result.ir_instructions += block.size();
+        result.translate += translated - start;
+        result.optimize += optimized - translated;
+        result.emit += emitted - optimized;
+
+        location = LocationDescriptor{block.EndLocation()};
+    }
+    backend.Clear();
+    return result;
+}
+
+void PrintHeader() {
+    fmt::print("{:<14} {:>9} {:>10} {:>10} {:>10} {:>10} {:>9} {:>10}\n", "corpus", "guest",
+               "translate", "optimize", "emit", "total", "IR/guest", "bytes/guest");
+    fmt::print("{:<14} {:>9} {:>10} {:>10} {:>10} {:>10} {:>9} {:>10}\n", "", "insts",
+               "Minst/s", "Minst/s", "Minst/s", "Minst/s", "", "");
+}
+
+void PrintResult(const std::string& name, const Result& result) {
+    const auto rate = [&](Clock::duration time) {
+        return result.guest_instructions / std::chrono::duration<double>(time).count() / 1e6;
+    };
+    const double guest_instructions = static_cast<double>(result.guest_instructions);
+
+    fmt::print("{:<14} {:>9} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>9.2f} {:>10.1f}\n", name,
+               result.guest_instructions, rate(result.translate), rate(result.optimize),
+               rate(result.emit), rate(result.translate + result.optimize + result.emit),
+               result.ir_instructions / guest_instructions,
+               result.host_bytes / guest_instructions);
+}
+
+/// Runs fn iterations + 1 times, discarding the first run as a warm-up.
+template <typename Fn>
+Result Repeat(size_t iterations, Fn fn) {
+    (void)fn();
+    Result total;
+    for (size_t i = 0; i < iterations; i++) {
+        total += fn();
+    }
+    return total;
+}
+
+template <typename T>
+std::vector<T> RepeatSequence(const std::vector<T>& sequence, size_t count) {
+    std::vector<T> result;
+    result.reserve(count);
+    while (result.size() < count) {
+        result.push_back(sequence[result.size() % sequence.size()]);
+    }
+    return result;
+}
+
+std::vector<u32> GenerateRandomArm(size_t count) {
+    const std::vector<std::tuple<std::string, const char*>> list{
+#define INST(fn, name, bitstring) {#fn, bitstring},
+#include "frontend/A32/decoder/arm.inc"
+#include "frontend/A32/decoder/asimd.inc"
+#include "frontend/A32/decoder/vfp.inc"
+#undef INST
+    };
+
+    // Coprocessor instructions cannot be emitted without coprocessors.
+    const std::vector<std::string> do_not_generate{
+        "arm_CDP", "arm_LDC", "arm_MCR", "arm_MCRR", "arm_MRC", "arm_MRRC", "arm_STC",
+    };
+
+    std::vector<InstructionGenerator> generators;
+    for (const auto& [fn, bitstring] : list) {
+        if (std::find(do_not_generate.begin(), do_not_generate.end(), fn) ==
+            do_not_generate.end()) {
+            generators.emplace_back(bitstring);
+        }
+    }
+
+    std::vector<u32> instructions;
+    while (instructions.size() < count) {
+        const auto& generator = generators[RandInt<size_t>(0, generators.size() - 1)];
+        const u32 instruction = generator.Generate();
+        // Conditional instructions should not be generated with the unconditional encoding.
+        if ((generator.Mask() & 0xF0000000) == 0 && (instruction & 0xF0000000) == 0xF0000000) {
+            continue;
+        }
+        instructions.push_back(instruction);
+    }
+    return instructions;
+}
+
+std::vector<u16> GenerateRandomThumb(size_t count) {
+    std::vector<u16> instructions;
+    while (instructions.size() < count) {
+        const u16 first_part = RandInt<u16>(0, 0xFFFF);
+        if (A32::IsThumb16(first_part)) {
+            if (A32::DecodeThumb16<A32::ThumbTranslatorVisitor>(first_part)) {
+                instructions.push_back(first_part);
+            }
+            continue;
+        }
+
+        const u16 second_part = RandInt<u16>(0, 0xFFFF);
+        const u32 instruction = (u32{first_part} << 16) | second_part;
+        if (A32::DecodeThumb32<A32::ThumbTranslatorVisitor>(instruction)) {
+            instructions.push_back(first_part);
+            instructions.push_back(second_part);
+        }
+    }
+    return instructions;
+}
+
+std::vector<u32> GenerateRandomA64(size_t count) {
+    const std::vector<std::tuple<std::string, const char*>> list{
+#define INST(fn, name, bitstring) {#fn, bitstring},
+#include "frontend/A64/decoder/a64.inc"
+#undef INST
+    };
+
+    std::vector<InstructionGenerator> generators;
+    for (const auto& [fn, bitstring] : list) {
+        if (fn != "UnallocatedEncoding") {
+            generators.emplace_back(bitstring);
+        }
+    }
+
+    std::vector<u32> instructions;
+    while (instructions.size() < count) {
+        instructions.push_back(generators[RandInt<size_t>(0, generators.size() - 1)].Generate());
+    }
+    return instructions;
+}
+
+// Sequences resembling compiled code: prologues, field accesses, short branches, floating-point
+// and SIMD arithmetic, and epilogues.
+
+const std::vector<u32> arm_sequence{
+    0xe92d4010, // push {r4, lr}
+    0xe1a04000, // mov r4, r0
+    0xe5940004, // ldr r0, [r4, #4]
+    0xe2800001, // add r0, r0, #1
+    0xe5840004, // str r0, [r4, #4]
+    0xe350000a, // cmp r0, #10
+    0xa3a00000, // movge r0, #0
+    0xe5941008, // ldr r1, [r4, #8]
+    0xe0810100, // add r0, r1, r0, lsl #2
+    0xed940b04, // vldr d0, [r4, #16]
+    0xee300b01, // vadd.f64 d0, d0, d1
+    0xed840b04, // vstr d0, [r4, #16]
+    0xf4212a8d, // vld1.32 {d2, d3}, [r1]!
+    0xf2024d56, // vmla.f32 q2, q1, q3
+    0xe8bd8010, // pop {r4, pc}
+};
+
+const std::vector<u16> thumb_sequence{
+    0xb510,         // push {r4, lr}
+    0x4604,         // mov r4, r0
+    0x6860,         // ldr r0, [r4, #4]
+    0x3001,         // adds r0, #1
+    0x6060,         // str r0, [r4, #4]
+    0x280a,         // cmp r0, #10
+    0xda00,         // bge +#0
+    0x2000,         // movs r0, #0
+    0xf8d4, 0x1008, // ldr.w r1, [r4, #8]
+    0xeb01, 0x0080, // add.w r0, r1, r0, lsl #2
+    0x5c0a,         // ldrb r2, [r1, r0]
+    0x00d2,         // lsls r2, r2, #3
+    0x8062,         // strh r2, [r4, #2]
+    0xfb02, 0xf000, // mul r0, r2, r0
+    0xbd10,         // pop {r4, pc}
+};
+
+const std::vector<u32> a64_sequence{
+    0xa9be7bfd, // stp x29, x30, [sp, #-32]!
+    0x910003fd, // mov x29, sp
+    0xf9000bf3, // str x19, [sp, #16]
+    0xaa0003f3, // mov x19, x0
+    0xb9400a68, // ldr w8, [x19, #8]
+    0x11000508, // add w8, w8, #1
+    0xb9000a68, // str w8, [x19, #8]
+    0x7100291f, // cmp w8, #10
+    0x5400006a, // b.ge #12
+    0xf9400260, // ldr x0, [x19]
+    0x8b080800, // add x0, x0, x8, lsl #2
+    0xacc10420, // ldp q0, q1, [x1], #32
+    0x4e21cc02, // fmla v2.4s, v0.4s, v1.4s
+    0x1e222863, // fadd s3, s3, s2
+    0x1e380069, // fcvtzs w9, s3
+    0xf9400bf3, // ldr x19, [sp, #16]
+    0xa8c27bfd, // ldp x29, x30, [sp], #32
+    0xd65f03c0, // ret
+};
+
+template <typename TestEnv>
+Result BenchA32(const std::vector<typename TestEnv::InstructionType>& code, bool thumb,
+                size_t iterations) {
+    TestEnv env;
+    env.code_mem = code;
+
+    A32::UserConfig conf;
+    conf.callbacks = &env;
+    // The emitter is too large to be allocated on the stack.
+    const auto backend = std::make_unique<Backend<A32EmitX64, A32JitState, A32::UserConfig>>(conf);
+
+    A32::PSR cpsr;
+    cpsr.T(thumb);
+    const A32::LocationDescriptor start{0, cpsr, A32::FPSCR{}};
+    const u32 end_pc = static_cast<u32>(code.size() * sizeof(code[0]));
+
+    const auto translate = [&](A32::LocationDescriptor location) {
+        return A32::Translate(location, CodeReader<A32::UserCallbacks, u32>{&env},
+                              {conf.define_unpredictable_behaviour, conf.hook_hint_instructions});
+    };
+    const auto optimize = [&](IR::Block& block) { Optimization::A32Optimize(block, conf); };
+
+    return Repeat(iterations,
+                  [&] { return CompileAll(start, end_pc, translate, optimize, *backend); });
+}
+
+Result BenchA64(const std::vector<u32>& code, size_t iterations) {
+    A64TestEnv env;
+    env.code_mem = code;
+
+    A64::ExclusiveMonitor monitor{1};
+    A64::UserConfig conf{&env};
+    conf.global_monitor = &monitor;
+    // The emitter is too large to be allocated on the stack.
+    const auto backend = std::make_unique<Backend<A64EmitX64, A64JitState, A64::UserConfig>>(conf);
+
+    const A64::LocationDescriptor start{0, FP::FPCR{}};
+    const u64 end_pc = code.size() * sizeof(u32);
+
+    const auto translate = [&](A64::LocationDescriptor location) {
+        A64::TranslationOptions options{conf.define_unpredictable_behaviour,
+                                        conf.wall_clock_cntpct};
+        options.max_instructions = conf.max_instructions_per_block;
+        return A64::Translate(location, CodeReader<A64::UserCallbacks, u64>{&env}, options);
+    };
+    const auto optimize = [&](IR::Block& block) {
+        Optimization::A64CallbackConfigPass(block, conf);
+        Optimization::A64Optimize(block, conf);
+    };
+
+    return Repeat(iterations,
+                  [&] { return CompileAll(start, end_pc, translate, optimize, *backend); });
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc > 3) {
+        fmt::print("usage: {} [instruction_count] [iterations]\n", argv[0]);
+        return 1;
+    }
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 0) : 100000;
+    const size_t iterations = argc > 2 ? std::strtoull(argv[2], nullptr, 0) : 5;
+
+    PrintHeader();
+    PrintResult("arm random", BenchA32<ArmTestEnv>(GenerateRandomArm(count), false, iterations));
+    PrintResult("arm sequence",
+                BenchA32<ArmTestEnv>(RepeatSequence(arm_sequence, count), false, iterations));
+    PrintResult("thumb random",
+                BenchA32<ThumbTestEnv>(GenerateRandomThumb(count), true, iterations));
+    PrintResult("thumb sequence",
+                BenchA32<ThumbTestEnv>(RepeatSequence(thumb_sequence, count), true, iterations));
+    PrintResult("a64 random", BenchA64(GenerateRandomA64(count), iterations));
+    PrintResult("a64 sequence", BenchA64(RepeatSequence(a64_sequence, count), iterations));
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <vector>
+
+#include <catch.hpp>
+
+#include "common/memory_pool.h"
+
+using namespace Dynarmic::Common;
+
+namespace {
+
+std::vector<void*> AllocMany(Pool& pool, size_t count) {
+    std::vector<void*> ret;
+    for (size_t i = 0; i < count; i++) {
+        ret.push_back(pool.Alloc());
+    }
+    return ret;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Pool: Reset reuses slabs", "[common]") {
+    Pool pool{16, 4};
+
+    // Ten objects span three slabs.
+    const std::vector<void*> first = AllocMany(pool, 10);
+    REQUIRE(static_cast<char*>(first[1]) - static_cast<char*>(first[0]) == 16);
+
+    pool.Reset();
+    REQUIRE(AllocMany(pool, 10) == first);
+}
+
+TEST_CASE("Pool: Reset trims retained slabs", "[common]") {
+    Pool pool{16, 4};
+
+    const std::vector<void*> first = AllocMany(pool, 10);
+
+    // Only the first slab is retained.
+    pool.Reset(1);
+    REQUIRE(AllocMany(pool, 4) == std::vector<void*>(first.begin(), first.begin() + 4));
+
+    // A pool always keeps at least one slab.
+    pool.Reset(0);
+    REQUIRE(pool.Alloc() == first[0]);
+
+    // Trimmed slabs are allocated again on demand.
+    pool.Reset(1);
+    REQUIRE(AllocMany(pool, 10).size() == 10);
+}
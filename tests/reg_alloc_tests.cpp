@@ -0,0 +1,78 @@
+/* This file is part of the dynarmic project.
+ * Copyright (c) 2021 MerryMage
+ * SPDX-License-Identifier: 0BSD
+ */
+
+#include <memory>
+
+#include <catch.hpp>
+
+#include "backend/x64/a32_jitstate.h"
+#include "backend/x64/block_of_code.h"
+#include "backend/x64/callback.h"
+#include "backend/x64/hostloc.h"
+#include "backend/x64/jitstate_info.h"
+#include "backend/x64/reg_alloc.h"
+#include "frontend/A32/ir_emitter.h"
+#include "frontend/A32/location_descriptor.h"
+#include "frontend/A32/types.h"
+#include "frontend/ir/basic_block.h"
+
+using namespace Dynarmic;
+using namespace Dynarmic::Backend::X64;
+
+namespace {
+
+// The code emitted by these tests is never run.
+void Unused() {}
+
+RunCodeCallbacks MakeRunCodeCallbacks() {
+    return RunCodeCallbacks{
+        std::make_unique<SimpleCallback>(&Unused),
+        std::make_unique<SimpleCallback>(&Unused),
+        std::make_unique<SimpleCallback>(&Unused),
+    };
+}
+
+} // anonymous namespace
+
+TEST_CASE("RegAlloc: Evicts the value whose next use is furthest away", "[x64]") {
+    BlockOfCode code{MakeRunCodeCallbacks(), JitStateInfo{A32JitState{}}, [](BlockOfCode&) {}};
+
+    for (const bool a_used_first : {false, true}) {
+        // With only two registers available, defining c requires one of a and b to be spilled.
+        const A32::LocationDescriptor location{0, A32::PSR{}, A32::FPSCR{}};
+        IR::Block block{location};
+        A32::IREmitter ir{block, location};
+
+        const IR::U32 a = ir.GetRegister(A32::Reg::R0);
+        const IR::U32 b = ir.GetRegister(A32::Reg::R1);
+        const IR::U32 c = ir.GetRegister(A32::Reg::R2);
+        ir.SetRegister(A32::Reg::R3, a_used_first ? a : b);
+        ir.SetRegister(A32::Reg::R4, a_used_first ? b : a);
+        ir.SetRegister(A32::Reg::R5, c);
+
+        RegAlloc reg_alloc{code, A32JitState::SpillCount, SpillToOpArg<A32JitState>,
+                           {HostLoc::RAX, HostLoc::RCX}, any_xmm};
+        reg_alloc.AnalyzeUses(block);
+
+        auto iter = block.begin();
+        for (size_t i = 0; i < 3; i++, ++iter) {
+            reg_alloc.BeginInstruction(&*iter);
+            reg_alloc.DefineValue(&*iter, reg_alloc.ScratchGpr());
+            reg_alloc.EndOfAllocScope();
+        }
+
+        // The value used next stays in a register and the other one is spilled.
+        for (const bool expect_in_gpr : {true, false, true}) {
+            reg_alloc.BeginInstruction(&*iter);
+            auto args = reg_alloc.GetArgumentInfo(&*iter);
+            REQUIRE(args[1].IsInGpr() == expect_in_gpr);
+            reg_alloc.UseGpr(args[1]);
+            reg_alloc.EndOfAllocScope();
+            ++iter;
+        }
+
+        reg_alloc.AssertNoMoreUses();
+    }
+}